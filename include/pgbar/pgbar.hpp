@@ -30,7 +30,15 @@
 #  define __PGBAR_UNIX    0
 #  define __PGBAR_UNKNOWN 0
 # elif defined( __unix__ )
+#  include <pthread.h>
+#  include <sys/ioctl.h>
 #  include <unistd.h>
+#  if defined( __linux__ )
+#   include <sched.h>
+#   include <sys/resource.h>
+#   include <sys/syscall.h>
+#   include <time.h>
+#  endif
 #  define __PGBAR_WIN     0
 #  define __PGBAR_UNIX    1
 #  define __PGBAR_UNKNOWN 0
@@ -41,6 +49,16 @@
 #  define __PGBAR_UNKNOWN 1
 # endif
 
+# if defined( __AVX2__ )
+#  include <immintrin.h>
+#  define __PGBAR_SIMD 2
+# elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#  include <emmintrin.h>
+#  define __PGBAR_SIMD 1
+# else
+#  define __PGBAR_SIMD 0
+# endif
+
 # if __PGBAR_CC_STD >= 202302L
 #  define __PGBAR_CXX23         1
 #  define __PGBAR_CXX23_CNSTXPR constexpr
@@ -50,6 +68,7 @@
 # endif
 # if __PGBAR_CC_STD >= 202002L
 #  include <concepts>
+#  include <ranges>
 #  define __PGBAR_CXX20         1
 #  define __PGBAR_NOUNIQUEADDR  [[no_unique_address]]
 #  define __PGBAR_UNLIKELY      [[unlikely]]
@@ -105,6 +124,7 @@
 # include <mutex>
 # include <queue>
 # include <string>
+# include <system_error>
 # include <thread>
 # include <type_traits>
 # include <utility>
@@ -553,6 +573,10 @@ namespace pgbar {
                                 && std::is_void<decltype( std::declval<M&>().unlock() )>::value>::type>
         : std::true_type {};
 # endif
+
+      // Whether the bar type is locked by `Threadunsafe`, it's specialized after `BasicBar`.
+      template<typename B>
+      struct is_threadunsafe_bar : std::false_type {};
     } // namespace trait
 
     namespace wrappers {
@@ -830,16 +854,22 @@ namespace pgbar {
                      "pgbar::iterators::IterSpan<I>: Only available for iterator types" );
 
     public:
+      // It keeps the category of `I`; the operators that `I` doesn't support are never instantiated.
       class iterator final {
         I current_;
 
       public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type        = typename std::iterator_traits<I>::value_type;
-        using difference_type   = void;
-        using pointer           = typename std::iterator_traits<I>::pointer;
-        using reference         = typename std::iterator_traits<I>::reference;
+        using iterator_category = typename std::iterator_traits<I>::iterator_category;
+# if __PGBAR_CXX20
+        using iterator_concept =
+          std::conditional_t<std::contiguous_iterator<I>, std::contiguous_iterator_tag, iterator_category>;
+# endif
+        using value_type      = typename std::iterator_traits<I>::value_type;
+        using difference_type = typename std::iterator_traits<I>::difference_type;
+        using pointer         = typename std::iterator_traits<I>::pointer;
+        using reference       = typename std::iterator_traits<I>::reference;
 
+        constexpr iterator() noexcept( std::is_nothrow_default_constructible<I>::value ) : current_ {} {}
         constexpr explicit iterator( I startpoint ) noexcept( std::is_nothrow_move_constructible<I>::value )
           : current_ { std::move( startpoint ) }
         {}
@@ -856,14 +886,56 @@ namespace pgbar {
           operator++();
           return before;
         }
+        __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator& operator--()
+        {
+          --current_;
+          return *this;
+        }
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator operator--( int )
+        {
+          auto before = *this;
+          operator--();
+          return before;
+        }
+        __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator& operator+=( difference_type increment )
+        {
+          current_ += increment;
+          return *this;
+        }
+        __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator& operator-=( difference_type decrement )
+        {
+          current_ -= decrement;
+          return *this;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator
+          operator+( iterator itr, difference_type n )
+        {
+          return itr += n;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator
+          operator+( difference_type n, iterator itr )
+        {
+          return itr += n;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator
+          operator-( iterator itr, difference_type n )
+        {
+          return itr -= n;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr difference_type operator-( const iterator& a,
+                                                                                        const iterator& b )
+        {
+          return a.current_ - b.current_;
+        }
 
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR reference operator*() noexcept
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr reference operator*() const { return *current_; }
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr pointer operator->() const
         {
-          return *current_;
+          return std::addressof( *current_ );
         }
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX17_CNSTXPR pointer operator->() noexcept
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr reference operator[]( difference_type n ) const
         {
-          return &current_;
+          return current_[n];
         }
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr bool operator==( const I& lhs ) const noexcept
@@ -884,6 +956,26 @@ namespace pgbar {
         {
           return !( a == b );
         }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator<( const iterator& a,
+                                                                             const iterator& b )
+        {
+          return a.current_ < b.current_;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator>( const iterator& a,
+                                                                             const iterator& b )
+        {
+          return b < a;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator<=( const iterator& a,
+                                                                              const iterator& b )
+        {
+          return !( b < a );
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator>=( const iterator& a,
+                                                                              const iterator& b )
+        {
+          return !( a < b );
+        }
       };
 
       using __detail::wrappers::IterSpanBase<I>::IterSpanBase;
@@ -908,18 +1000,19 @@ namespace pgbar {
                      "pgbar::iterators::IterSpan<P*>: Only available for pointer types" );
 
     public:
+      // A reversed range isn't contiguous, so the category stops at random access.
       class iterator final {
-      public:
         P* current_;
         bool reversed_;
 
       public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type        = P;
-        using difference_type   = void;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = typename std::remove_cv<P>::type;
+        using difference_type   = std::ptrdiff_t;
         using pointer           = P*;
-        using reference         = typename std::add_lvalue_reference<value_type>::type;
+        using reference         = typename std::add_lvalue_reference<P>::type;
 
+        constexpr iterator() noexcept : current_ { nullptr }, reversed_ { false } {}
         __PGBAR_CXX14_CNSTXPR iterator( P* startpoint, P* endpoint ) noexcept
           : current_ { startpoint }, reversed_ { false }
         {
@@ -927,6 +1020,9 @@ namespace pgbar {
           __PGBAR_ASSERT( endpoint != nullptr );
           reversed_ = endpoint < startpoint;
         }
+        constexpr iterator( P* current, bool reversed ) noexcept
+          : current_ { current }, reversed_ { reversed }
+        {}
         __PGBAR_CXX20_CNSTXPR ~iterator() noexcept = default;
 
         __PGBAR_CXX14_CNSTXPR __PGBAR_INLINE_FN iterator& operator++() noexcept
@@ -943,14 +1039,80 @@ namespace pgbar {
           operator++();
           return before;
         }
+        __PGBAR_CXX14_CNSTXPR __PGBAR_INLINE_FN iterator& operator--() noexcept
+        {
+          if ( reversed_ )
+            ++current_;
+          else
+            --current_;
+          return *this;
+        }
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator operator--( int ) noexcept
+        {
+          auto before = *this;
+          operator--();
+          return before;
+        }
+        __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator& operator+=( difference_type increment ) noexcept
+        {
+          current_ += reversed_ ? -increment : increment;
+          return *this;
+        }
+        __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator& operator-=( difference_type decrement ) noexcept
+        {
+          current_ += reversed_ ? decrement : -decrement;
+          return *this;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator
+          operator+( iterator itr, difference_type n ) noexcept
+        {
+          return itr += n;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator
+          operator+( difference_type n, iterator itr ) noexcept
+        {
+          return itr += n;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator
+          operator-( iterator itr, difference_type n ) noexcept
+        {
+          return itr -= n;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr difference_type operator-(
+          const iterator& a,
+          const iterator& b ) noexcept
+        {
+          return a.reversed_ ? b.current_ - a.current_ : a.current_ - b.current_;
+        }
 
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR reference operator*() noexcept
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr reference operator*() const noexcept
         {
           return *current_;
         }
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX17_CNSTXPR pointer operator->() noexcept
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr pointer operator->() const noexcept { return current_; }
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr reference operator[]( difference_type n ) const noexcept
+        {
+          return reversed_ ? current_[-n] : current_[n];
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator<( const iterator& a,
+                                                                             const iterator& b ) noexcept
+        {
+          return a.reversed_ ? b.current_ < a.current_ : a.current_ < b.current_;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator>( const iterator& a,
+                                                                             const iterator& b ) noexcept
+        {
+          return b < a;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator<=( const iterator& a,
+                                                                              const iterator& b ) noexcept
+        {
+          return !( b < a );
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator>=( const iterator& a,
+                                                                              const iterator& b ) noexcept
         {
-          return &current_;
+          return !( a < b );
         }
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr bool operator==( const P* lhs ) const noexcept
@@ -991,7 +1153,8 @@ namespace pgbar {
       }
       __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr iterator end() const noexcept
       {
-        return iterator( this->end_, this->end_ );
+        // The end iterator must know the direction too, or the distance to it can't be measured.
+        return iterator( this->end_, this->end_ < this->start_ );
       }
     };
 
@@ -1046,48 +1209,88 @@ namespace pgbar {
         }
       } // namespace escape
 
+      // A fixed-size ANSI escape code of a color, the longest one is "\x1B[38;2;255;255;255m".
+      class ColorCode final {
+        types::Char data_[19];
+        std::uint8_t size_;
+
+        __PGBAR_CXX14_CNSTXPR void push( const types::Char* str ) noexcept
+        {
+          for ( ; *str != '\0'; ++str )
+            data_[size_++] = *str;
+        }
+        __PGBAR_CXX14_CNSTXPR void push( std::uint8_t channel ) noexcept
+        {
+          if ( channel >= 100 )
+            data_[size_++] = static_cast<types::Char>( '0' + channel / 100 );
+          if ( channel >= 10 )
+            data_[size_++] = static_cast<types::Char>( '0' + channel / 10 % 10 );
+          data_[size_++] = static_cast<types::Char>( '0' + channel % 10 );
+        }
+        __PGBAR_CXX14_CNSTXPR void assign( types::HexRGB rgb ) noexcept
+        {
+          if ( rgb == __PGBAR_DEFAULT )
+            return push( "\x1B[0m" );
+
+          switch ( rgb & 0x00FFFFFF ) { // discard the high 8 bits
+          case __PGBAR_BLACK:   return push( "\x1B[30m" );
+          case __PGBAR_RED:     return push( "\x1B[31m" );
+          case __PGBAR_GREEN:   return push( "\x1B[32m" );
+          case __PGBAR_YELLOW:  return push( "\x1B[33m" );
+          case __PGBAR_BLUE:    return push( "\x1B[34m" );
+          case __PGBAR_MAGENTA: return push( "\x1B[35m" );
+          case __PGBAR_CYAN:    return push( "\x1B[36m" );
+          case __PGBAR_WHITE:   return push( "\x1B[37m" );
+          default:              break;
+          }
+          push( "\x1B[38;2;" );
+          push( static_cast<std::uint8_t>( ( rgb >> 16 ) & 0xFF ) );
+          push( ";" );
+          push( static_cast<std::uint8_t>( ( rgb >> 8 ) & 0xFF ) );
+          push( ";" );
+          push( static_cast<std::uint8_t>( rgb & 0xFF ) );
+          push( "m" );
+        }
+
+      public:
+        constexpr ColorCode() noexcept : data_ {}, size_ { 0 } {}
+        __PGBAR_CXX14_CNSTXPR explicit ColorCode( types::HexRGB rgb ) noexcept : ColorCode()
+        {
+          assign( rgb );
+        }
+        __PGBAR_CXX20_CNSTXPR ~ColorCode() noexcept = default;
+
+        __PGBAR_NODISCARD constexpr const types::Char* data() const noexcept { return data_; }
+        __PGBAR_NODISCARD constexpr types::Size size() const noexcept { return size_; }
+        __PGBAR_NODISCARD constexpr bool empty() const noexcept { return size_ == 0; }
+      };
+
       /**
-       * Convert a hexidecimal RGB color value to an ANSI escape code.
+       * Convert a hexidecimal RGB color value to an ANSI escape code,
+       * which can be done at compile time since C++14.
        *
        * Return nothing if defined `PGBAR_COLORLESS`.
        */
-      __PGBAR_CXX20_CNSTXPR types::String rgb2ansi( types::HexRGB rgb )
-# ifdef PGBAR_COLORLESS
-        noexcept
+      __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR ColorCode rgb2ansi(
+        types::HexRGB rgb ) noexcept
       {
-        return {};
-      }
+# ifdef PGBAR_COLORLESS
+        return ( (void)rgb, ColorCode() );
 # else
-        noexcept( false )
-      {
-        if ( rgb == __PGBAR_DEFAULT )
-          return types::String( escape::reset_font );
-
-        switch ( rgb & 0x00FFFFFF ) { // discard the high 8 bits
-        case __PGBAR_BLACK:   return "\x1B[30m";
-        case __PGBAR_RED:     return "\x1B[31m";
-        case __PGBAR_GREEN:   return "\x1B[32m";
-        case __PGBAR_YELLOW:  return "\x1B[33m";
-        case __PGBAR_BLUE:    return "\x1B[34m";
-        case __PGBAR_MAGENTA: return "\x1B[35m";
-        case __PGBAR_CYAN:    return "\x1B[36m";
-        case __PGBAR_WHITE:   return "\x1B[37m";
-        default:
-          return "\x1B[38;2;" + std::to_string( ( rgb >> 16 ) & 0xFF ) + ";"
-               + std::to_string( ( rgb >> 8 ) & 0xFF ) + ";" + std::to_string( rgb & 0xFF ) + "m";
-        }
-      }
+        return ColorCode( rgb );
 # endif
+      }
 
       /**
-       * Converts RGB color strings to hexidecimal values.
+       * Converts RGB color strings to hexidecimal values, which can be done at compile time since C++17.
        *
        * Always returns 0 if defined `PGBAR_COLORLESS`.
        *
        * @throw exception::InvalidArgument
        * If the size of RGB color string is not 7 or 4, and doesn't begin with character `#`.
        */
-      __PGBAR_CXX20_CNSTXPR types::HexRGB hex2rgb( types::ROStr hex ) noexcept( false )
+      __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX17_CNSTXPR types::HexRGB hex2rgb( types::ROStr hex )
+        noexcept( false )
       {
         if ( hex.front() != '#' || ( hex.size() != 7 && hex.size() != 4 ) )
           throw exception::InvalidArgument( "pgbar: invalid hex color format" );
@@ -1154,55 +1357,359 @@ namespace pgbar {
           return isatty( STDERR_FILENO );
 # endif
       }
-    } // namespace console
 
-    namespace charset {
-      // A type of wrapper that stores the mapping between Unicode code chart and character width.
-      class CodeChart final {
-        types::UCodePoint start_, end_;
-        types::Size width_;
-
-      public:
-        constexpr CodeChart( types::UCodePoint start, types::UCodePoint end, types::Size width ) noexcept
-          : start_ { start }, end_ { end }, width_ { width }
-        { // This is an internal component, so we assume the arguments are always valid.
-          __PGBAR_ASSERT( start_ <= end_ );
-        }
-        __PGBAR_CXX20_CNSTXPR ~CodeChart() noexcept = default;
+      template<StreamChannel StreamType>
+      /**
+       * Get the number of columns of the terminal that the output stream is binded to.
+       *
+       * Returns 0 if it's unknown, or the local platform is neither `Windows` nor `unix-like`.
+       */
+      __PGBAR_NODISCARD types::Size terminal_width() noexcept
+      {
+# if __PGBAR_WIN
+        HANDLE stream_handle;
+        if __PGBAR_CXX17_CNSTXPR ( StreamType == StreamChannel::Stdout )
+          stream_handle = GetStdHandle( STD_OUTPUT_HANDLE );
+        else
+          stream_handle = GetStdHandle( STD_ERROR_HANDLE );
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        __PGBAR_UNLIKELY if ( stream_handle == INVALID_HANDLE_VALUE
+                              || !GetConsoleScreenBufferInfo( stream_handle, &info ) ) return 0;
+        return static_cast<types::Size>( info.srWindow.Right - info.srWindow.Left + 1 );
 
-        // Check whether the Unicode code point is within this code chart.
-        __PGBAR_NODISCARD constexpr bool contains( types::UCodePoint codepoint ) const noexcept
-        {
-          return start_ <= codepoint && codepoint <= end_;
-        }
-        // Return the character width of this Unicode code chart.
-        __PGBAR_NODISCARD constexpr types::Size width() const noexcept { return width_; }
-        // Return the size of this range of Unicode code chart.
-        __PGBAR_NODISCARD constexpr types::UCodePoint size() const noexcept { return end_ - start_ + 1; }
-        // Return the start Unicode code point of this code chart.
-        __PGBAR_NODISCARD constexpr types::UCodePoint head() const noexcept { return start_; }
-        // Return the end Unicode code point of this code chart.
-        __PGBAR_NODISCARD constexpr types::UCodePoint tail() const noexcept { return end_; }
+# elif __PGBAR_UNIX
+        struct winsize window;
+        const int fd = StreamType == StreamChannel::Stdout ? STDOUT_FILENO : STDERR_FILENO;
+        __PGBAR_UNLIKELY if ( ioctl( fd, TIOCGWINSZ, &window ) == -1 ) return 0;
+        return window.ws_col;
+# else
+        return 0;
+# endif
+      }
+    } // namespace console
 
-        __PGBAR_NODISCARD friend constexpr bool operator<( const CodeChart& a, const CodeChart& b ) noexcept
-        {
-          return a.end_ < b.start_;
-        }
-        __PGBAR_NODISCARD friend constexpr bool operator>( const CodeChart& a, const CodeChart& b ) noexcept
-        {
-          return a.start_ > b.end_;
-        }
-        __PGBAR_NODISCARD friend constexpr bool operator>( const CodeChart& a,
-                                                           const types::UCodePoint& b ) noexcept
+    namespace charset {
+      /**
+       * A two-level lookup table of the render width of each Unicode code point below U+40000:
+       * the code point selects a page in `pages`, then its 2-bit width within that page in `widths`.
+       *
+       * It's a class template so that the arrays can be defined in a header before C++17.
+       */
+      template<typename = void>
+      class WidthTable final {
+        // Return the position of the code point's width among the concatenated distinct pages.
+        __PGBAR_NODISCARD static constexpr types::Size position( types::UCodePoint codepoint ) noexcept
         {
-          return a.start_ > b;
+          return ( static_cast<types::Size>( pages[codepoint >> page_bits] ) << page_bits )
+               | ( codepoint & ( ( 1u << page_bits ) - 1 ) );
         }
-        __PGBAR_NODISCARD friend constexpr bool operator<( const CodeChart& a,
-                                                           const types::UCodePoint& b ) noexcept
+        __PGBAR_NODISCARD static constexpr types::Size width_at( types::Size pos ) noexcept
         {
-          return a.end_ < b;
+          return static_cast<types::Size>( widths[pos >> 5] >> ( ( pos & 0x1F ) * 2 ) ) & 0x3;
         }
+
+      public:
+        // Return the width of a code point below U+40000.
+        __PGBAR_NODISCARD static constexpr types::Size width( types::UCodePoint codepoint ) noexcept
+        {
+          return width_at( position( codepoint ) );
+        }
+
+        // Generated by misc/unicode-width.py from the Unicode Character Database 14.0.0.
+        static constexpr types::Size page_bits = 7;
+        // The distinct page index of each 128 code points below U+40000.
+        static constexpr std::uint8_t pages[2048] = {
+          0, 1, 2, 2, 2, 2, 3, 2, 2, 4, 2, 5, 6, 7, 8, 9,
+          10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,
+          26, 27, 28, 29, 2, 2, 30, 2, 2, 2, 2, 2, 2, 2, 31, 32,
+          33, 34, 35, 2, 36, 37, 38, 39, 40, 41, 2, 42, 2, 2, 2, 2,
+          43, 44, 2, 2, 2, 2, 45, 46, 2, 2, 2, 47, 48, 49, 50, 51,
+          2, 2, 2, 2, 2, 2, 52, 2, 2, 53, 54, 55, 2, 56, 57, 58,
+          59, 60, 61, 62, 63, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 64, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 65, 2, 2, 66, 67, 2, 2,
+          68, 69, 70, 71, 72, 73, 2, 74, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 75,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 57, 57, 57, 57, 76, 2, 2, 2, 2, 2, 77, 54, 78, 79,
+          2, 2, 2, 80, 2, 81, 82, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 83, 84, 2, 2, 2, 2, 85, 2, 2, 86, 87, 88,
+          89, 90, 91, 92, 93, 94, 95, 2, 96, 97, 2, 98, 99, 100, 101, 2,
+          102, 2, 103, 104, 105, 106, 2, 2, 107, 108, 109, 110, 2, 111, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 112, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 113, 114, 2, 2, 2, 2, 2, 2, 2, 115, 116,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 117,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 118, 119, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 120,
+          57, 57, 121, 57, 57, 122, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 123, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 124, 2,
+          2, 2, 125, 126, 127, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 2, 2, 2, 128, 129, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          130, 2, 114, 2, 2, 131, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          2, 132, 133, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+          134, 135, 2, 136, 57, 57, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146,
+          147, 148, 149, 57, 150, 57, 2, 2, 57, 57, 57, 57, 57, 57, 57, 151,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 151,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+          57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 151,
+        };
+        // The widths of each distinct page, 2 bits per code point and 32 code points per word.
+        static constexpr std::uint64_t widths[608] = {
+          0x0000000000000000, 0x5555555555555555, 0x5555555555555555, 0x1555555555555555,
+          0x0000000000000000, 0x5555555551555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x5555555500000000,
+          0x5555555555500015, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x0000000155555555, 0x1000000000000000, 0x5555555555551041, 0x5555555555555555,
+          0x5440000055555000, 0x5555555555555555, 0x0000000000155555, 0x5555555455555555,
+          0x5555555555555555, 0x5555555555555555, 0x1000055555555555, 0x5555555550041400,
+          0x5555555115555555, 0x0000000055555555, 0x5555555555400000, 0x5555555555555555,
+          0x5555555555555555, 0x5555555400000555, 0x5555555555555555, 0x5155550000155555,
+          0x0010055555555555, 0x5555555550010100, 0x5501555555555555, 0x5555555555555555,
+          0x0000555055555555, 0x5555555555555555, 0x0000000000055555, 0x0000000000000000,
+          0x5555555555555540, 0x5445555555555555, 0x5555000151540001, 0x5555555555555505,
+          0x5555555555555551, 0x5455555555555555, 0x5555555551555401, 0x4555555555555505,
+          0x5555555555555541, 0x5455555555555555, 0x5555555150141541, 0x5555515055555555,
+          0x5555555555555541, 0x5455555555555555, 0x5555555551541001, 0x0005555555555505,
+          0x5555555555555551, 0x1455555555555555, 0x5555415551555401, 0x5555555555555505,
+          0x5555555555555545, 0x5555555555555555, 0x5555555551555554, 0x5555555555555555,
+          0x5555555555555454, 0x0455555555555555, 0x5555415550040554, 0x5555555555555505,
+          0x5555555555555551, 0x1455555555555555, 0x5555555550554555, 0x5555555555555505,
+          0x5555555555555550, 0x5415555555555555, 0x5555555551555401, 0x5555555555555505,
+          0x5555555555555551, 0x5555555555555555, 0x5555440555455555, 0x5555555555555555,
+          0x5555555555555555, 0x5540005155555555, 0x5555555540001555, 0x5555555555555555,
+          0x5555555555555555, 0x5400005155555555, 0x5555555550005555, 0x5555555555555555,
+          0x5550555555555555, 0x5551115555555555, 0x5555555555555555, 0x4000000155555555,
+          0x0001000001550400, 0x5400000000000000, 0x5555555555554555, 0x5555555555555555,
+          0x5555555555555555, 0x4141000401555555, 0x0550555555555555, 0x5555540155555554,
+          0x5155555551554145, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x0000000000000000,
+          0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+          0x5555555555555555, 0x5555555555555555, 0x0155555555555555, 0x5555555555555555,
+          0x5555540555555555, 0x5555550555555555, 0x5555550555555555, 0x5555550555555555,
+          0x5555555555555555, 0x5000105555555555, 0x5155550000014555, 0x5555555555555555,
+          0x5555555500155555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555554155, 0x5555555555515555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5501554555541540, 0x5555555555555555, 0x5555555555555555,
+          0x5514155555555555, 0x5555555555555555, 0x4000455555555555, 0x1400001554000144,
+          0x5555555555555555, 0x0000000055555555, 0x5555555540000000, 0x5555555555555555,
+          0x5555555555555500, 0x5440045555555555, 0x5555555555555545, 0x5555550000155555,
+          0x5555555555555550, 0x5555555550105005, 0x5555555555555555, 0x5555555011504555,
+          0x5555555555555555, 0x5555050000555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x0000004055555555, 0x5550545551540004,
+          0x5555555555555555, 0x5555555555555555, 0x0000000000000000, 0x0000000000000000,
+          0x5555555500155555, 0x5555555540005555, 0x5555555555555555, 0x5555555500000000,
+          0x5555555555555555, 0x5555555555555555, 0x0000000055555555, 0x5555555400000000,
+          0x55A5555555555555, 0x5555555555695555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555559656A95555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x6955555555555555,
+          0x55555A5555555555, 0x5555555555555555, 0x555555AAAAAA5555, 0x9555555555555555,
+          0x5555559555555555, 0x6955555555A55559, 0x5555565565555A55, 0x596559A555655555,
+          0x5555555555A55955, 0x5555555555565555, 0x55559A9566555555, 0x5555555555555555,
+          0x5555A95555555555, 0x9555555655555555, 0x5555555555555555, 0x5555555555555555,
+          0x5695555555555555, 0x5555555555555555, 0x5555595655555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555015555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x1555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000000000000000,
+          0xAA9AAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x555555AAAAAAAAAA,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x55555AAAAAAAAAAA, 0x55AAAAAA55555555,
+          0xAAAAAAAAAAAAAAAA, 0x6AAAAAAAA00AAAAA, 0xAAAAAAAAAAAAAAA9, 0xAAAAAAAAAAAAAAAA,
+          0xAA816AAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA,
+          0xAAAAAAAAAAAAA955, 0xAAAAAAA9AAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA,
+          0xAAAAAAAA6AAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAA555555AA,
+          0x6AAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAA5555AAAA, 0xAAAAAAAAAAAAAAAA,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x5555555555555555, 0x5555555555555555,
+          0xAAAAAAAA56AAAAAA, 0xAAAAAAAAAAAAAAAA, 0x5555555555556AAA, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5000004015555555,
+          0x0555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555055555555,
+          0x5555555555154545, 0x5555555554554155, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555055, 0x1555555000000000,
+          0x5555555555555555, 0x5555555550000555, 0x5555555000001555, 0x56AAAAAAAAAAAAAA,
+          0x5555555555555540, 0x5050051555555555, 0x5555555555555555, 0x5555555555555155,
+          0x5555555555555555, 0x5555414140015555, 0x5555555554555515, 0x5455555555555555,
+          0x5555555555555555, 0x0554140455555555, 0x5555555555555551, 0x5555455550555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555551545155,
+          0xAAAAAAAAAAAAAAAA, 0x00000000555555AA, 0x0000000000000000, 0x0000000000000000,
+          0x4555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x555AAAAA00000000, 0xAAAAAAAA00000000, 0xAAAAAA6AAAAAAAAA, 0x5555555555AA6AAA,
+          0xAAAAAAAAAAAAAAA9, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x5555555555555556,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5500000055556AAA,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5155555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555554,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5540055555555555,
+          0x5555555500554101, 0x1540555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555554155,
+          0x5555555555555555, 0x5555555555550055, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555554155555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555400000555, 0x5555555555555555,
+          0x5555555555555005, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555551, 0x0000555555555555, 0x5555555555554000, 0x1555541455555555,
+          0x5555555555555550, 0x5141401555555555, 0x5555555551555545, 0x5555555555555555,
+          0x5555555555555540, 0x5555540001001555, 0x5555555555555555, 0x5555551555555555,
+          0x5555555555555550, 0x4000055555555555, 0x5555555514015555, 0x5555555555555555,
+          0x5555555555555555, 0x4555045015555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x1555555555555555, 0x5555555555400015,
+          0x5555555555555550, 0x5415555555555555, 0x5555555555555554, 0x5555540054000555,
+          0x5555555555555555, 0x0000555555555555, 0x4555555555554405, 0x5555555555555555,
+          0x5555555555555555, 0x1544001555555555, 0x5555555555555504, 0x5555555555555555,
+          0x5555555555555555, 0x1055500555555555, 0x5055555555555554, 0x5555555555555555,
+          0x5555555555555555, 0x1140001555555555, 0x5555555555555554, 0x5555555555555555,
+          0x5555555555555555, 0x5555100051155555, 0x5555555555555555, 0x5555555555555555,
+          0x0155555555555555, 0x5555555555001005, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5541000015555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x4415555555555555, 0x5555555555555515, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5505005555555555, 0x5555555555555554,
+          0x5555555555400001, 0x4014001555555555, 0x5501400155551555, 0x5555555555555555,
+          0x5550400000055555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x1000400055555555, 0x5555555555555555, 0x5555555555555555,
+          0x0000000555555555, 0x5555410400050000, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x1045400155555555, 0x5555555555551000, 0x5555555555555555,
+          0x5555115055555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555541555555555,
+          0x5555555555555555, 0x5554000055555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555540055555555,
+          0x5555555555555555, 0x5555400055555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555515555555, 0x5555555555555555,
+          0x5555554015555555, 0x5555555555555555, 0x5555555555555555, 0x5555555A555554AA,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x5555AAAAAAAAAAAA,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x55555AAAAAAAAAAA, 0x5555555555555555,
+          0x555555555556AAAA, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x69AAA9AA55555555,
+          0xAAAAAAAAAAAAAAAA, 0x555555555555556A, 0x5555556A55555555, 0xAAAAAAAA5555AA55,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x55AAAAAAAAAAAAAA,
+          0x4155555555555555, 0x5555555555555500, 0x5555555555555555, 0x5555555555555555,
+          0x0000000000000000, 0x0000000050000000, 0x5555555555554000, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000001555501555,
+          0x5555555555000140, 0x5555555550055555, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555405, 0x5555555555555555,
+          0x0000000000000000, 0x0015400000000000, 0x0000000000000000, 0x5555515554000000,
+          0x0015555555555455, 0x5555555500000001, 0x5555555555555555, 0x5555555555555555,
+          0x0014000000004000, 0x5555555555400410, 0x5555555555555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555545555555, 0x5555555555555555, 0x5555555500555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555400055555555, 0x5555555555555555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555400055, 0x5555555555555555,
+          0x5555555555555655, 0x55555555AA555555, 0x5555555555555555, 0x5555555555555555,
+          0xAAAAAA5555555555, 0x5555555695555555, 0x5555555695555556, 0xAAAAA55555555555,
+          0x556AAAA965555555, 0xAAAAAAAAA5555555, 0xAAAAAAAAAAAAAAAA, 0x5555555555555AAA,
+          0xAAAAAAAAAAAAAAAA, 0xAAAA9AAAA9555556, 0xAAAAAAAAAAAAAAAA, 0xA6AAAAAAAAAAAAAA,
+          0x555555AAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x555555AA956AAAAA, 0xAAAA5656AAAAAAAA,
+          0xAAAAAAAAAAAAAAAA, 0x6AAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAA6, 0xAAAAAAAAAAAAAAAA,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x96AAAAAAAAAAAAAA,
+          0xAAAAAAAAAAAAAAAA, 0x5AAAAAAAAAAAAAAA, 0xAAAAAAAA6A955555, 0x556555555555AAAA,
+          0x5555695555555555, 0x5555555555555655, 0x5555555555555555, 0xAA95555555555555,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x55555555AAAAAAAA, 0x5555555555555555,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAA96A56555AAA, 0xAAAAAA55AA955555,
+          0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0xAAAAAA5555555555,
+          0x5555555555555555, 0x5555555555555555, 0xAAA9555555555555, 0xAAAAAAAAAAAAAAAA,
+          0x55555555AA555555, 0x5555555555555555, 0xAAA55555AAAA5555, 0x5555555555555555,
+          0x55555555AAAA5555, 0xAAAAAAA5A5555555, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA,
+          0xAAAAAAAAAA555555, 0xAA6AAAAAAAAAAAAA, 0xAAAAAAAAAAAA9AAA, 0xAAAAAAAAAAAAAAAA,
+          0x5555555555555555, 0x5555555555555555, 0xAAAAAA5555555555, 0xAAAAAAAAA5555555,
+          0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0xAAAAAAAAAAAAAAAA, 0x5AAAAAAAAAAAAAAA,
+        };
       };
+# if !__PGBAR_CXX17
+      template<typename T>
+      constexpr std::uint8_t WidthTable<T>::pages[];
+      template<typename T>
+      constexpr std::uint64_t WidthTable<T>::widths[];
+# endif
 
       // A simple UTF-8 string implementation.
       class U8String final {
@@ -1211,42 +1718,60 @@ namespace pgbar {
         types::Size width_;
         std::string bytes_;
 
-      public:
-        __PGBAR_NODISCARD static __PGBAR_CNSTEVAL __PGBAR_INLINE_FN std::array<CodeChart, 47>
-          code_charts() noexcept
-        {
-          // See the Unicode CodeCharts documentation for complete code points.
-          // Also can see the `if-else` version in misc/UTF-8-test.cpp
-          return {
-            { { 0x0, 0x19, 0 },        { 0x20, 0x7E, 1 },        { 0x7F, 0xA0, 0 },
-             { 0xA1, 0xAC, 1 },       { 0xAD, 0xAD, 0 },        { 0xAE, 0x2FF, 1 },
-             { 0x300, 0x36F, 0 },     { 0x370, 0x1FFF, 1 },     { 0x2000, 0x200F, 0 },
-             { 0x2010, 0x2010, 1 },   { 0x2011, 0x2011, 0 },    { 0x2012, 0x2027, 1 },
-             { 0x2028, 0x202F, 0 },   { 0x2030, 0x205E, 1 },    { 0x205F, 0x206F, 0 },
-             { 0x2070, 0x2E7F, 1 },   { 0x2E80, 0xA4CF, 2 },    { 0xA4D0, 0xA95F, 1 },
-             { 0xA960, 0xA97F, 2 },   { 0xA980, 0xABFF, 1 },    { 0xAC00, 0xD7FF, 2 },
-             { 0xE000, 0xF8FF, 2 },   { 0xF900, 0xFAFF, 2 },    { 0xFB00, 0xFDCF, 1 },
-             { 0xFDD0, 0xFDEF, 0 },   { 0xFDF0, 0xFDFF, 1 },    { 0xFE00, 0xFE0F, 0 },
-             { 0xFE10, 0xFE1F, 2 },   { 0xFE20, 0xFE2F, 0 },    { 0xFE30, 0xFE6F, 2 },
-             { 0xFE70, 0xFEFE, 1 },   { 0xFEFF, 0xFEFF, 0 },    { 0xFF00, 0xFF60, 2 },
-             { 0xFF61, 0xFFDF, 1 },   { 0xFFE0, 0xFFE6, 2 },    { 0xFFE7, 0xFFEF, 1 },
-             { 0xFFF0, 0xFFFF, 1 },   { 0x10000, 0x1F8FF, 2 },  { 0x1F900, 0x1FBFF, 3 },
-             { 0x1FF80, 0x1FFFF, 0 }, { 0x20000, 0x3FFFD, 2 },  { 0x3FFFE, 0x3FFFF, 0 },
-             { 0xE0000, 0xE007F, 0 }, { 0xE0100, 0xE01EF, 0 },  { 0xEFF80, 0xEFFFF, 0 },
-             { 0xFFF80, 0xFFFFF, 2 }, { 0x10FF80, 0x10FFFF, 2 } }
-          };
+        /**
+         * Count the printable ASCII characters at the front of `[first, last)`,
+         * which are checked 32, 16 or 8 bytes at a time.
+         */
+        __PGBAR_NODISCARD static __PGBAR_INLINE_FN types::Size ascii_prefix(
+          const types::Char* first,
+          const types::Char* last ) noexcept
+        {
+          auto itr = first;
+# if __PGBAR_SIMD >= 2
+          for ( const auto control = _mm256_set1_epi8( 0x1F ), del = _mm256_set1_epi8( 0x7F );
+                last - itr >= 32;
+                itr += 32 ) {
+            const auto block     = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( itr ) );
+            // The signed comparison also rejects the bytes above 0x7F.
+            const auto printable = _mm256_andnot_si256( _mm256_cmpeq_epi8( block, del ),
+                                                        _mm256_cmpgt_epi8( block, control ) );
+            if ( _mm256_movemask_epi8( printable ) != -1 )
+              break;
+          }
+# endif
+# if __PGBAR_SIMD >= 1
+          for ( const auto control = _mm_set1_epi8( 0x1F ), del = _mm_set1_epi8( 0x7F ); last - itr >= 16;
+                itr += 16 ) {
+            const auto block     = _mm_loadu_si128( reinterpret_cast<const __m128i*>( itr ) );
+            const auto printable =
+              _mm_andnot_si128( _mm_cmpeq_epi8( block, del ), _mm_cmpgt_epi8( block, control ) );
+            if ( _mm_movemask_epi8( printable ) != 0xFFFF )
+              break;
+          }
+# endif
+          constexpr std::uint64_t ones = 0x0101010101010101ull, highs = 0x8080808080808080ull;
+          for ( ; last - itr >= 8; itr += 8 ) {
+            std::uint64_t word;
+            std::memcpy( &word, itr, sizeof( word ) );
+            const auto not_del = word ^ ( ones * 0x7F );
+            // Stop at any byte that has the high bit set, is below 0x20 or equals 0x7F.
+            if ( ( word & highs ) != 0 || ( ( word - ones * 0x20 ) & ~word & highs ) != 0
+                 || ( ( not_del - ones ) & ~not_del & highs ) != 0 )
+              break;
+          }
+          while ( itr != last && static_cast<unsigned char>( *itr ) >= 0x20
+                  && static_cast<unsigned char>( *itr ) < 0x7F )
+            ++itr;
+          return static_cast<types::Size>( itr - first );
         }
-        __PGBAR_NODISCARD static __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR types::Size char_width(
+
+      public:
+        // Return the number of columns the code point takes in a terminal, which is 0, 1 or 2.
+        __PGBAR_NODISCARD static __PGBAR_INLINE_FN constexpr types::Size char_width(
           types::UCodePoint codepoint ) noexcept
         {
-          auto&& charts = code_charts();
-          __PGBAR_ASSERT( std::is_sorted( charts.cbegin(), charts.cend() ) );
-          // Compare with the `if-else` version, here we can search for code points with O(logn).
-          const auto itr = std::lower_bound( charts.cbegin(), charts.cend(), codepoint );
-          if ( itr != charts.cend() && itr->contains( codepoint ) )
-            return itr->width();
-
-          return 1; // Default fallback
+          // Above the table, only the tags and the variation selectors in U+E0000..U+E0FFF take no column.
+          return codepoint < 0x40000 ? WidthTable<>::width( codepoint ) : ( codepoint >> 12 ) == 0xE0 ? 0 : 1;
         }
         /**
          * @throw exception::InvalidArgument
@@ -1260,6 +1785,19 @@ namespace pgbar {
         {
           types::Size width = 0;
           for ( types::Size i = 0; i < u8_str.size(); ) {
+            // Each printable ASCII character takes one column, they're skipped in blocks unless it's a
+            // constant evaluation, where the blocks can't be read and each of them is measured below.
+# if __PGBAR_CXX20
+            if ( !std::is_constant_evaluated() )
+# endif
+            {
+              const auto num_ascii = ascii_prefix( u8_str.data() + i, u8_str.data() + u8_str.size() );
+              width += num_ascii;
+              i += num_ascii;
+              if ( i == u8_str.size() )
+                break;
+            }
+
             const auto start_point = u8_str.data() + i;
             // After RFC 3629, the maximum length of each standard UTF-8 character is 4 bytes.
             const auto first_byte  = static_cast<types::UCodePoint>( *start_point );
@@ -1428,89 +1966,190 @@ namespace pgbar {
         return formatting<Style>( width, __str.size(), __str.str() );
       }
 
-      // A simple string buffer, unrelated to the `std::stringbuf` in the STL.
+      // Count the decimal digits of `value`.
+      __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR types::Size count_digits(
+        std::uint64_t value ) noexcept
+      {
+        types::Size digits = 1;
+        for ( ; value >= 10; value /= 10 )
+          ++digits;
+        return digits;
+      }
+
+      /**
+       * A simple string buffer, unrelated to the `std::stringbuf` in the STL.
+       *
+       * The first `inline_capacity` bytes are stored in the object itself,
+       * and the memory it has grown to is kept until `release()` is called or it's destroyed.
+       */
       class Stringbuf {
         using self = Stringbuf;
 
-      protected:
-        std::vector<types::Char> buffer_;
+      public:
+        static constexpr types::Size inline_capacity = 256;
+
+      private:
+        types::Char* data_;
+        types::Size size_;
+        types::Size capacity_;
+        types::Char inline_[inline_capacity];
+
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN bool on_heap() const noexcept { return data_ != inline_; }
+
+        void reallocate( types::Size capacity ) &
+        {
+          __PGBAR_ASSERT( capacity >= size_ );
+          auto new_data = capacity > inline_capacity ? new types::Char[capacity] : inline_;
+          if ( new_data == data_ )
+            return;
+          if ( size_ != 0 )
+            std::memcpy( new_data, data_, size_ );
+          if ( on_heap() )
+            delete[] data_;
+          data_     = new_data;
+          capacity_ = new_data == inline_ ? inline_capacity : capacity;
+        }
+
+        // Make room for `num` more bytes, and return where they begin.
+        __PGBAR_INLINE_FN types::Char* grow( types::Size num ) &
+        {
+          if ( capacity_ - size_ < num )
+            reallocate( ( std::max )( size_ + num, capacity_ + capacity_ / 2 ) );
+          const auto position = data_ + size_;
+          size_ += num;
+          return position;
+        }
 
       public:
-        __PGBAR_CXX20_CNSTXPR Stringbuf() noexcept = default;
+        Stringbuf() noexcept : data_ { inline_ }, size_ { 0 }, capacity_ { inline_capacity } {}
 
-        __PGBAR_CXX20_CNSTXPR Stringbuf( const self& lhs ) { operator=( lhs ); }
-        __PGBAR_CXX20_CNSTXPR Stringbuf( self&& rhs ) noexcept : Stringbuf() { swap( rhs ); }
-        __PGBAR_CXX20_CNSTXPR __PGBAR_INLINE_FN self& operator=( const self& lhs ) &
+        Stringbuf( const self& lhs ) : Stringbuf() { operator=( lhs ); }
+        Stringbuf( self&& rhs ) noexcept : Stringbuf() { swap( rhs ); }
+        __PGBAR_INLINE_FN self& operator=( const self& lhs ) &
         {
           __PGBAR_ASSERT( this != std::addressof( lhs ) );
-          buffer_ = lhs.buffer_;
-          return *this;
+          clear();
+          return append( lhs.data_, lhs.data_ + lhs.size_ );
         }
-        __PGBAR_CXX20_CNSTXPR __PGBAR_INLINE_FN self& operator=( self&& rhs ) & noexcept
+        __PGBAR_INLINE_FN self& operator=( self&& rhs ) & noexcept
         {
           __PGBAR_ASSERT( this != std::addressof( rhs ) );
           swap( rhs );
           return *this;
         }
 
-        __PGBAR_CXX20_CNSTXPR virtual ~Stringbuf() noexcept = default;
+        virtual ~Stringbuf() noexcept
+        {
+          if ( on_heap() )
+            delete[] data_;
+        }
 
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR bool empty() const noexcept { return buffer_.empty(); }
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR void clear() & noexcept { buffer_.clear(); }
+        __PGBAR_INLINE_FN bool empty() const noexcept { return size_ == 0; }
+        __PGBAR_INLINE_FN void clear() & noexcept { size_ = 0; }
+        __PGBAR_INLINE_FN types::Size size() const noexcept { return size_; }
+        __PGBAR_INLINE_FN types::Size capacity() const noexcept { return capacity_; }
+        __PGBAR_INLINE_FN const types::Char* data() const noexcept { return data_; }
 
         // Releases the buffer space completely
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR void release() & noexcept
+        __PGBAR_INLINE_FN void release() & noexcept
         {
           clear();
-          buffer_.shrink_to_fit();
+          if ( on_heap() ) {
+            delete[] data_;
+            data_     = inline_;
+            capacity_ = inline_capacity;
+          }
         }
 
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR self& reserve( types::Size capacity ) &
+        __PGBAR_INLINE_FN self& reserve( types::Size capacity ) &
         {
-          buffer_.reserve( capacity );
+          if ( capacity > capacity_ )
+            reallocate( capacity );
           return *this;
         }
+        /**
+         * Reserve `num` more bytes at once, and return where they begin;
+         * the caller writes all of them without any further checks.
+         */
+        __PGBAR_INLINE_FN types::Char* expand( types::Size num ) & { return grow( num ); }
 
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR self& append( types::Char info, types::Size __num = 1 ) &
+        __PGBAR_INLINE_FN self& append( types::Char info, types::Size __num = 1 ) &
         {
-          buffer_.insert( buffer_.end(), __num, info );
+          if ( __num != 0 )
+            std::memset( grow( __num ), info, __num );
+          return *this;
+        }
+        /**
+         * Append `__num` copies of the `length` bytes at `pattern`,
+         * each copy doubles the bytes written so far until `__num` is reached.
+         */
+        self& append( const types::Char* pattern, types::Size length, types::Size __num ) &
+        {
+          const auto total = length * __num;
+          __PGBAR_UNLIKELY if ( total == 0 ) return *this;
+          // The pattern may be in this buffer, which is moved by the growth.
+          const bool inside = pattern >= data_ && pattern < data_ + size_;
+          const auto offset = pattern - data_;
+          const auto target = grow( total );
+          std::memcpy( target, inside ? data_ + offset : pattern, length );
+          for ( types::Size written = length; written < total; ) {
+            const auto chunk = ( std::min )( written, total - written );
+            std::memcpy( target + written, target, chunk );
+            written += chunk;
+          }
           return *this;
         }
         template<types::Size N>
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR self& append( const char ( &info )[N],
-                                                              types::Size __num = 1 ) &
+        __PGBAR_INLINE_FN self& append( const char ( &info )[N], types::Size __num = 1 ) &
         {
           __PGBAR_ASSERT( N != 0 );
-          for ( types::Size _ = 0; _ < __num; ++_ )
-            buffer_.insert( buffer_.cend(), info, info + N );
-          return *this;
+          // The terminator of a string literal isn't part of the text.
+          return append( info, info[N - 1] == '\0' ? N - 1 : N, __num );
         }
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR self& append( types::ROStr info, types::Size __num = 1 ) &
+        __PGBAR_INLINE_FN self& append( types::ROStr info, types::Size __num = 1 ) &
         {
-          __PGBAR_ASSERT( info != nullptr );
-          for ( types::Size _ = 0; _ < __num; ++_ )
-            buffer_.insert( buffer_.cend(), info.data(), info.data() + info.size() );
-          return *this;
+          return append( info.data(), info.size(), __num );
         }
         template<typename T>
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR
+        __PGBAR_INLINE_FN
           typename std::enable_if<std::is_same<typename std::decay<T>::type, types::String>::value
                                     || std::is_same<typename std::decay<T>::type, types::ROStr>::value,
                                   self&>::type
           append( T&& info, types::Size __num = 1 ) &
         {
-          for ( types::Size _ = 0; _ < __num; ++_ )
-            buffer_.insert( buffer_.cend(), info.cbegin(), info.cend() );
-          return *this;
+          return append( info.data(), info.size(), __num );
         }
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR self& append( const charset::U8String& info,
-                                                              types::Size __num = 1 )
+        __PGBAR_INLINE_FN self& append( const charset::U8String& info, types::Size __num = 1 )
         {
           return append( info.str(), __num );
         }
+        __PGBAR_INLINE_FN self& append( const console::ColorCode& info ) &
+        {
+          return append( info.data(), info.size(), 1 );
+        }
+        __PGBAR_INLINE_FN self& append( const types::Char* first, const types::Char* last ) &
+        {
+          return append( first, static_cast<types::Size>( last - first ), 1 );
+        }
+        // Append `value` in decimal, padded on the left with `fill` up to `width` characters.
+        __PGBAR_INLINE_FN self& append_number( std::uint64_t value,
+                                               types::Size width = 0,
+                                               types::Char fill  = constants::blank ) &
+        {
+          const auto len    = count_digits( value );
+          const auto padded = ( std::max )( width, len );
+          auto target       = expand( padded );
+          std::memset( target, fill, padded - len );
+          target += padded;
+          do {
+            *--target = static_cast<types::Char>( '0' + value % 10 );
+            value /= 10;
+          } while ( value != 0 );
+          return *this;
+        }
 
         template<typename T>
-        friend __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR
+        friend __PGBAR_INLINE_FN
           typename std::enable_if<std::is_same<typename std::decay<T>::type, types::Char>::value
                                     || std::is_same<typename std::decay<T>::type, types::String>::value
                                     || std::is_same<typename std::decay<T>::type, types::ROStr>::value
@@ -1523,24 +2162,38 @@ namespace pgbar {
         {
           return stream.append( std::forward<T>( info ) );
         }
-        friend __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR self& operator<<( self& stream,
-                                                                         const charset::U8String& info )
+        friend __PGBAR_INLINE_FN self& operator<<( self& stream, const charset::U8String& info )
+        {
+          return stream.append( info );
+        }
+        friend __PGBAR_INLINE_FN self& operator<<( self& stream, const console::ColorCode& info )
         {
           return stream.append( info );
         }
         template<types::Size N>
-        friend __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR self& operator<<( self& stream,
-                                                                         const char ( &info )[N] )
+        friend __PGBAR_INLINE_FN self& operator<<( self& stream, const char ( &info )[N] )
         {
           return stream.append( info );
         }
 
-        __PGBAR_CXX20_CNSTXPR void swap( Stringbuf& lhs ) noexcept
+        void swap( Stringbuf& lhs ) noexcept
         {
           __PGBAR_ASSERT( this != std::addressof( lhs ) );
-          buffer_.swap( lhs.buffer_ );
+          if ( on_heap() && lhs.on_heap() )
+            std::swap( data_, lhs.data_ );
+          else if ( on_heap() || lhs.on_heap() ) {
+            // Hand the heap memory over, and move the inline bytes the other way.
+            auto& heap  = on_heap() ? *this : lhs;
+            auto& local = on_heap() ? lhs : *this;
+            std::memcpy( heap.inline_, local.inline_, local.size_ );
+            local.data_ = heap.data_;
+            heap.data_  = heap.inline_;
+          } else
+            std::swap_ranges( inline_, inline_ + ( std::max )( size_, lhs.size_ ), lhs.inline_ );
+          std::swap( size_, lhs.size_ );
+          std::swap( capacity_, lhs.capacity_ );
         }
-        friend __PGBAR_CXX20_CNSTXPR void swap( Stringbuf& a, Stringbuf& b ) noexcept { a.swap( b ); }
+        friend void swap( Stringbuf& a, Stringbuf& b ) noexcept { a.swap( b ); }
       };
 
       template<StreamChannel StreamType>
@@ -1557,6 +2210,82 @@ namespace pgbar {
         return stream;
       }
 
+      // Writes the data to `stdout` or `stderr` directly.
+      template<StreamChannel StreamType>
+      void write_channel( const types::Char* data, types::Size size )
+      {
+# if __PGBAR_WIN
+        DWORD written = 0;
+        if __PGBAR_CXX17_CNSTXPR ( StreamType == StreamChannel::Stdout ) {
+          auto h_stdout = GetStdHandle( STD_OUTPUT_HANDLE );
+          __PGBAR_UNLIKELY if ( h_stdout == INVALID_HANDLE_VALUE ) throw exception::SystemError(
+            "pgbar: cannot open the standard output stream" );
+          WriteFile( h_stdout, data, size, &written, nullptr );
+        } else {
+          auto h_stderr = GetStdHandle( STD_ERROR_HANDLE );
+          __PGBAR_UNLIKELY if ( h_stderr == INVALID_HANDLE_VALUE ) throw exception::SystemError(
+            "pgbar: cannot open the standard error stream" );
+          WriteFile( h_stderr, data, size, &written, nullptr );
+        }
+# elif __PGBAR_UNIX
+        if __PGBAR_CXX17_CNSTXPR ( StreamType == StreamChannel::Stdout )
+          write( STDOUT_FILENO, data, size );
+        else
+          write( STDERR_FILENO, data, size );
+# else
+        if __PGBAR_CXX17_CNSTXPR ( StreamType == StreamChannel::Stdout )
+          std::cout.write( data, size ).flush();
+        else
+          std::cerr.write( data, size ).flush();
+# endif
+      }
+
+      /**
+       * While a thread is gathering, the frames it flushes are kept here per channel,
+       * and `close()` writes each channel out with a single call.
+       */
+      class FrameBatch final {
+        std::vector<types::Char> pending_[2];
+        bool gathering_ = false;
+
+      public:
+        // Each thread has its own batch.
+        static FrameBatch& local() noexcept
+        {
+          static thread_local FrameBatch batch;
+          return batch;
+        }
+
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN bool gathering() const noexcept { return gathering_; }
+        __PGBAR_INLINE_FN void open() & noexcept { gathering_ = true; }
+
+        __PGBAR_INLINE_FN void append( StreamChannel channel, const types::Char* data, types::Size size ) &
+        {
+          auto& pending = pending_[static_cast<types::Size>( channel )];
+          pending.insert( pending.end(), data, data + size );
+        }
+
+        void close() &
+        {
+          gathering_ = false;
+          auto& out  = pending_[static_cast<types::Size>( StreamChannel::Stdout )];
+          auto& err  = pending_[static_cast<types::Size>( StreamChannel::Stderr )];
+          // Clear them first, so a failed write doesn't leave stale frames behind.
+          std::vector<types::Char> out_data, err_data;
+          out_data.swap( out );
+          err_data.swap( err );
+          if ( !out_data.empty() )
+            write_channel<StreamChannel::Stdout>( out_data.data(), out_data.size() );
+          if ( !err_data.empty() )
+            write_channel<StreamChannel::Stderr>( err_data.data(), err_data.size() );
+          // Keep the capacity for the next tick.
+          out_data.clear();
+          err_data.clear();
+          out.swap( out_data );
+          err.swap( err_data );
+        }
+      };
+
       /**
        * A helper output stream that writes the data to `stdout` or `stderr` directly.
        *
@@ -1576,30 +2305,11 @@ namespace pgbar {
 
         self& flush() &
         {
-# if __PGBAR_WIN
-          DWORD written = 0;
-          if __PGBAR_CXX17_CNSTXPR ( StreamType == StreamChannel::Stdout ) {
-            auto h_stdout = GetStdHandle( STD_OUTPUT_HANDLE );
-            __PGBAR_UNLIKELY if ( h_stdout == INVALID_HANDLE_VALUE ) throw exception::SystemError(
-              "pgbar: cannot open the standard output stream" );
-            WriteFile( h_stdout, buffer_.data(), buffer_.size(), &written, nullptr );
-          } else {
-            auto h_stderr = GetStdHandle( STD_ERROR_HANDLE );
-            __PGBAR_UNLIKELY if ( h_stderr == INVALID_HANDLE_VALUE ) throw exception::SystemError(
-              "pgbar: cannot open the standard error stream" );
-            WriteFile( h_stderr, buffer_.data(), buffer_.size(), &written, nullptr );
-          }
-# elif __PGBAR_UNIX
-          if __PGBAR_CXX17_CNSTXPR ( StreamType == StreamChannel::Stdout )
-            write( STDOUT_FILENO, buffer_.data(), buffer_.size() );
-          else
-            write( STDERR_FILENO, buffer_.data(), buffer_.size() );
-# else
-          if __PGBAR_CXX17_CNSTXPR ( StreamType == StreamChannel::Stdout )
-            std::cout.write( buffer_.data(), buffer_.size() ).flush();
+          auto& batch = FrameBatch::local();
+          if ( batch.gathering() )
+            batch.append( StreamType, data(), size() );
           else
-            std::cerr.write( buffer_.data(), buffer_.size() ).flush();
-# endif
+            write_channel<StreamType>( data(), size() );
           clear();
           return *this;
         }
@@ -1634,6 +2344,24 @@ namespace pgbar {
         __PGBAR_CXX20_CNSTXPR ~RenderFnWrapper() noexcept = default;
         virtual void run() { fntor_(); }
       };
+
+      // Type-erased sampler used by the observe mode of progress bars.
+      struct ProgressFn {
+        __PGBAR_CXX20_CNSTXPR virtual ~ProgressFn() noexcept = default;
+        virtual types::Size run()                            = 0;
+      };
+      template<typename F>
+      class ProgressFnWrapper final : public ProgressFn {
+        F fntor_;
+
+      public:
+        __PGBAR_CXX14_CNSTXPR explicit ProgressFnWrapper( F fn )
+          noexcept( std::is_nothrow_move_constructible<F>::value )
+          : fntor_ { std::move( fn ) }
+        {}
+        __PGBAR_CXX20_CNSTXPR ~ProgressFnWrapper() noexcept = default;
+        virtual types::Size run() { return static_cast<types::Size>( fntor_() ); }
+      };
     } // namespace wrappers
 
     namespace concurrent {
@@ -1670,13 +2398,15 @@ namespace pgbar {
 
       protected:
         std::atomic<types::Size> num_readers_;
+        // Counts the exclusive sections, so that whatever is derived from the guarded data can be cached.
+        std::atomic<types::Size> generation_;
         Mutex writer_mtx_;
 
       public:
         SharedMutex( const self& )     = delete;
         self& operator=( const self& ) = delete;
 
-        SharedMutex() noexcept : num_readers_ { 0 } {}
+        SharedMutex() noexcept : num_readers_ { 0 }, generation_ { 0 } {}
         ~SharedMutex() noexcept = default;
 
         void lock() & noexcept
@@ -1702,9 +2432,13 @@ namespace pgbar {
           }
           return false;
         }
-        __PGBAR_INLINE_FN void unlock() & noexcept { writer_mtx_.unlock(); }
-
-        void lock_shared() & noexcept
+        __PGBAR_INLINE_FN void unlock() & noexcept
+        {
+          generation_.fetch_add( 1, std::memory_order_release );
+          writer_mtx_.unlock();
+        }
+
+        void lock_shared() & noexcept
         {
           writer_mtx_.lock();
 
@@ -1728,6 +2462,13 @@ namespace pgbar {
           __PGBAR_ASSERT( num_readers_ > 0 ); // underflow checking
           num_readers_.fetch_sub( 1, std::memory_order_release );
         }
+
+        // Get the number of exclusive sections that have ended so far.
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size generation(
+          std::memory_order order = std::memory_order_acquire ) const noexcept
+        {
+          return generation_.load( order );
+        }
       };
       class SharedMutexRef final {
         SharedMutex& mtx_;
@@ -1746,6 +2487,8 @@ namespace pgbar {
         using self = ExceptionBox;
 
         std::exception_ptr exception_;
+        // Mirrors whether `exception_` is set, so that checking for an exception takes no lock.
+        std::atomic<bool> filled_ { false };
         mutable SharedMutex mtx_;
 
       public:
@@ -1762,16 +2505,16 @@ namespace pgbar {
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN bool empty() const noexcept
         {
-          __detail::concurrent::SharedMutexRef shared_end { mtx_ };
-          std::lock_guard<SharedMutexRef> lock { shared_end };
-          return !static_cast<bool>( exception_ );
+          return !filled_.load( std::memory_order_acquire );
         }
 
         __PGBAR_INLINE_FN self& store( std::exception_ptr e ) & noexcept
         {
           std::lock_guard<SharedMutex> lock { mtx_ };
-          if ( !exception_ )
+          if ( !exception_ ) {
             exception_ = e;
+            filled_.store( static_cast<bool>( exception_ ), std::memory_order_release );
+          }
           return *this;
         }
         __PGBAR_INLINE_FN std::exception_ptr load() const noexcept
@@ -1784,6 +2527,7 @@ namespace pgbar {
         {
           std::lock_guard<SharedMutex> lock { mtx_ };
           exception_ = std::exception_ptr();
+          filled_.store( false, std::memory_order_release );
           return *this;
         }
 
@@ -1795,6 +2539,7 @@ namespace pgbar {
             return;
           auto exception_ptr = exception_;
           exception_         = std::exception_ptr();
+          filled_.store( false, std::memory_order_release );
           if ( exception_ptr )
             std::rethrow_exception( std::move( exception_ptr ) );
         }
@@ -1810,9 +2555,261 @@ namespace pgbar {
 #else
           exception_.swap( lhs.exception_ );
 #endif
+          filled_.store( static_cast<bool>( exception_ ), std::memory_order_release );
+          lhs.filled_.store( static_cast<bool>( lhs.exception_ ), std::memory_order_release );
         }
         friend void swap( ExceptionBox& a, ExceptionBox& b ) noexcept { a.swap( b ); }
       };
+
+      /**
+       * A counter that spreads the increments over several cache-line-padded slots,
+       * so that the threads ticking at the same time don't fight for the same cache line.
+       *
+       * Each thread is bound to one slot for its lifetime; the slots are lazily allocated by `clear()`.
+       */
+      class ShardedCounter final {
+        using self = ShardedCounter;
+
+        // The slot size is padded to a whole cache line, so two slots never share one.
+        struct Slot {
+          std::atomic<types::Size> cnt_;
+          types::Char padding_[64 - sizeof( std::atomic<types::Size> )];
+        };
+
+        std::unique_ptr<Slot[]> slots_;
+        types::Size mask_;
+
+        __PGBAR_NODISCARD static __PGBAR_INLINE_FN types::Size thread_index() noexcept
+        {
+          static std::atomic<types::Size> next_index { 0 };
+          static thread_local const types::Size index = next_index.fetch_add( 1, std::memory_order_relaxed );
+          return index;
+        }
+
+      public:
+        // The number of the pending increments that a slot may hold before it should be flushed.
+        static constexpr types::Size threshold = 64;
+
+        ShardedCounter( const self& )  = delete;
+        self& operator=( const self& ) = delete;
+
+        ShardedCounter() noexcept : slots_ { nullptr }, mask_ { 0 } {}
+        ~ShardedCounter() noexcept = default;
+
+        // Allocate the slots if they don't exist, and set all of them to zero.
+        void clear() &
+        {
+          if ( slots_ == nullptr ) {
+            types::Size num_slots = 1;
+            for ( const types::Size num_cores = std::thread::hardware_concurrency();
+                  num_slots < num_cores && num_slots < 64; )
+              num_slots <<= 1;
+            slots_.reset( new Slot[num_slots]() );
+            mask_ = num_slots - 1;
+          }
+          for ( types::Size i = 0; i <= mask_; ++i )
+            slots_[i].cnt_.store( 0, std::memory_order_relaxed );
+        }
+
+        // Add `num` to the slot of the current thread, and return the value that slot holds now.
+        __PGBAR_INLINE_FN types::Size add( types::Size num ) & noexcept
+        {
+          __PGBAR_ASSERT( slots_ != nullptr );
+          // Sequential consistency keeps the later load of the flushed counter from being reordered
+          // before this increment; that is what guarantees the last increments are never stranded.
+          return slots_[thread_index() & mask_].cnt_.fetch_add( num, std::memory_order_seq_cst ) + num;
+        }
+        // Take away all the increments from the slot of the current thread.
+        __PGBAR_INLINE_FN types::Size take() & noexcept
+        {
+          __PGBAR_ASSERT( slots_ != nullptr );
+          return slots_[thread_index() & mask_].cnt_.exchange( 0, std::memory_order_seq_cst );
+        }
+        // Take away all the increments from every slot.
+        types::Size take_all() & noexcept
+        {
+          __PGBAR_ASSERT( slots_ != nullptr );
+          types::Size total = 0;
+          for ( types::Size i = 0; i <= mask_; ++i )
+            total += slots_[i].cnt_.exchange( 0, std::memory_order_seq_cst );
+          return total;
+        }
+
+        // Return the sum of all slots, it is only a snapshot while other threads are still counting.
+        __PGBAR_NODISCARD types::Size sum() const noexcept
+        {
+          if ( slots_ == nullptr )
+            return 0;
+          types::Size total = 0;
+          for ( types::Size i = 0; i <= mask_; ++i )
+            total += slots_[i].cnt_.load( std::memory_order_acquire );
+          return total;
+        }
+        // Return the number of the increments that all slots can hold without flushing.
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size capacity() const noexcept
+        {
+          return slots_ == nullptr ? 0 : ( mask_ + 1 ) * threshold;
+        }
+      };
+
+      /**
+       * Splits the index interval `[0, size)` evenly among the workers.
+       *
+       * A worker takes chunks from the front of its own interval,
+       * and steals the back half of another worker's interval once its own is exhausted.
+       */
+      class WorkStealer final {
+        using self = WorkStealer;
+
+        struct Queue {
+          Mutex mtx_;
+          types::Size front_, back_;
+          // Keeps the hot fields of two neighbouring queues out of the same cache line.
+          types::Char padding_[64];
+        };
+
+        std::unique_ptr<Queue[]> queues_;
+        types::Size num_workers_;
+
+      public:
+        WorkStealer( const self& )     = delete;
+        self& operator=( const self& ) = delete;
+
+        WorkStealer( types::Size size, types::Size num_workers )
+          : queues_ { new Queue[num_workers] }, num_workers_ { num_workers }
+        {
+          __PGBAR_ASSERT( num_workers > 0 );
+          for ( types::Size i = 0; i < num_workers; ++i ) {
+            queues_[i].front_ = size / num_workers * i + ( i < size % num_workers ? i : size % num_workers );
+            queues_[i].back_  = queues_[i].front_ + size / num_workers + ( i < size % num_workers ? 1 : 0 );
+          }
+        }
+        ~WorkStealer() noexcept = default;
+
+        /**
+         * Take at most `grain` indexes for the worker `id`, and store them in `[first, last)`.
+         *
+         * @return Return false if there is no more work.
+         */
+        bool take( types::Size id, types::Size grain, types::Size& first, types::Size& last ) & noexcept
+        {
+          __PGBAR_ASSERT( id < num_workers_ );
+          auto& own = queues_[id];
+          while ( true ) {
+            {
+              std::lock_guard<Mutex> lock { own.mtx_ };
+              if ( own.front_ < own.back_ ) {
+                first       = own.front_;
+                last        = own.back_ - own.front_ > grain ? own.front_ + grain : own.back_;
+                own.front_  = last;
+                return true;
+              }
+            }
+
+            types::Size stolen_front = 0, stolen_back = 0;
+            for ( types::Size i = 1; i < num_workers_ && stolen_front == stolen_back; ++i ) {
+              auto& victim = queues_[( id + i ) % num_workers_];
+              std::lock_guard<Mutex> lock { victim.mtx_ };
+              if ( victim.front_ < victim.back_ ) {
+                stolen_back   = victim.back_;
+                stolen_front  = victim.back_ - ( victim.back_ - victim.front_ + 1 ) / 2;
+                victim.back_  = stolen_front;
+              }
+            }
+            if ( stolen_front == stolen_back )
+              return false;
+
+            std::lock_guard<Mutex> lock { own.mtx_ };
+            own.front_ = stolen_front;
+            own.back_  = stolen_back;
+          }
+        }
+      };
+
+      /**
+       * A process-wide set of parked threads, which run the workers of `parallel_iterate`
+       * so that each call doesn't have to spawn new threads.
+       *
+       * Only one job runs on it at a time; `try_start` returns false if it's taken,
+       * e.g. by a nested or concurrent `parallel_iterate`, and the caller should use its own threads.
+       */
+      class WorkerPool final {
+        using self = WorkerPool;
+        using Job  = void ( * )( void*, types::Size );
+
+        std::mutex mtx_;
+        std::condition_variable wake_, done_;
+        std::vector<std::thread> threads_;
+        Job job_                 = nullptr;
+        void* context_           = nullptr;
+        types::Size generation_  = 0;
+        types::Size num_wanted_  = 0;
+        types::Size num_running_ = 0;
+        bool busy_               = false;
+
+        WorkerPool() = default;
+
+        // `seen` is the generation of the last job before the thread was started.
+        void loop( types::Size id, types::Size seen ) noexcept
+        {
+          std::unique_lock<std::mutex> lock { mtx_ };
+          while ( true ) {
+            wake_.wait( lock, [this, seen]() noexcept { return generation_ != seen; } );
+            seen = generation_;
+            if ( id > num_wanted_ )
+              continue;
+            const auto job     = job_;
+            const auto context = context_;
+            lock.unlock();
+            job( context, id );
+            lock.lock();
+            if ( --num_running_ == 0 )
+              done_.notify_all();
+          }
+        }
+
+      public:
+        WorkerPool( const self& )      = delete;
+        self& operator=( const self& ) = delete;
+
+        // Never destroyed, the parked threads simply end with the process.
+        static self& instance()
+        {
+          static self* const pool = new self();
+          return *pool;
+        }
+
+        /**
+         * Run `job( context, id )` on `num_workers` threads with the ids `1` to `num_workers`,
+         * then `wait` must be called once it returns true.
+         */
+        bool try_start( types::Size num_workers, Job job, void* context ) &
+        {
+          __PGBAR_ASSERT( num_workers > 0 );
+          std::lock_guard<std::mutex> lock { mtx_ };
+          if ( busy_ )
+            return false;
+          while ( threads_.size() < num_workers ) {
+            const auto id = threads_.size() + 1, seen = generation_;
+            threads_.emplace_back( [this, id, seen]() { loop( id, seen ); } );
+          }
+          busy_        = true;
+          job_         = job;
+          context_     = context;
+          num_wanted_  = num_workers;
+          num_running_ = num_workers;
+          ++generation_;
+          wake_.notify_all();
+          return true;
+        }
+        // Block until every worker of the running job has returned.
+        void wait() & noexcept
+        {
+          std::unique_lock<std::mutex> lock { mtx_ };
+          done_.wait( lock, [this]() noexcept { return num_running_ == 0; } );
+          busy_ = false;
+        }
+      };
     } // namespace concurrent
   } // namespace __detail
 
@@ -1948,11 +2945,11 @@ namespace pgbar {
 
 # undef __PGBAR_OPTIONS_HELPER
 # define __PGBAR_OPTIONS_HELPER( StructName, ParamName )                                \
-   __PGBAR_OPTIONS( StructName, __detail::types::String )                               \
-   __PGBAR_CXX20_CNSTXPR StructName( __detail::types::ROStr ParamName )                 \
+   __PGBAR_OPTIONS( StructName, __detail::console::ColorCode )                          \
+   __PGBAR_CXX17_CNSTXPR StructName( __detail::types::ROStr ParamName )                 \
      : data_ { __detail::console::rgb2ansi( __detail::console::hex2rgb( ParamName ) ) } \
    {}                                                                                   \
-   __PGBAR_CXX20_CNSTXPR StructName( __detail::types::HexRGB ParamName )                \
+   __PGBAR_CXX14_CNSTXPR StructName( __detail::types::HexRGB ParamName ) noexcept       \
      : data_ { __detail::console::rgb2ansi( ParamName ) }                               \
    {}
 
@@ -2109,6 +3106,47 @@ namespace pgbar {
    __PGBAR_CXX14_CNSTXPR ClassName& operator=( ClassName&& rhs )& noexcept = default;                        \
    __PGBAR_CXX20_CNSTXPR virtual ~ClassName() noexcept                     = 0;
 
+      // The pieces of a bar that only change with the config, a frame copies slices of them.
+      struct BarCache {
+        // The filler repeated over the whole bar, and the number of bytes of each repetition.
+        io::Stringbuf filler;
+        types::Size filler_step = 0;
+        io::Stringbuf remains;
+        types::Size remains_step = 0;
+        // Every frame of the lead with its fonts, `lead_ends` holds where each of them ends.
+        io::Stringbuf leads;
+        std::vector<types::Size> lead_ends;
+
+        // Start over, keeping the memory for the next config.
+        __PGBAR_INLINE_FN void clear() & noexcept
+        {
+          filler.clear();
+          remains.clear();
+          leads.clear();
+          lead_ends.clear();
+          filler_step = remains_step = 0;
+        }
+        // Mark the end of a lead frame just written to `leads`.
+        __PGBAR_INLINE_FN void end_lead() & { lead_ends.push_back( leads.size() ); }
+
+        __PGBAR_INLINE_FN io::Stringbuf& append_filler( io::Stringbuf& buffer, types::Size num ) const
+        {
+          __PGBAR_ASSERT( num * filler_step <= filler.size() );
+          return buffer.append( filler.data(), filler.data() + num * filler_step );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& append_remains( io::Stringbuf& buffer, types::Size num ) const
+        {
+          __PGBAR_ASSERT( num * remains_step <= remains.size() );
+          return buffer.append( remains.data(), remains.data() + num * remains_step );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& append_lead( io::Stringbuf& buffer, types::Size index ) const
+        {
+          __PGBAR_ASSERT( index < lead_ends.size() );
+          return buffer.append( leads.data() + ( index == 0 ? 0 : lead_ends[index - 1] ),
+                                leads.data() + lead_ends[index] );
+        }
+      };
+
       template<typename Base, typename Derived>
       class Fonts : public Base {
         enum class Mask : types::Size { Colored = 0, Bolded };
@@ -2134,12 +3172,14 @@ namespace pgbar {
         }
 
       protected:
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR types::ROStr build_color( types::ROStr ansi_color ) const
+        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR console::ColorCode build_color(
+          const console::ColorCode& ansi_color ) const noexcept
         {
-          return fonts_[trait::as_val( Mask::Colored )] ? ansi_color : constants::nil_str;
+          return fonts_[trait::as_val( Mask::Colored )] ? ansi_color : console::ColorCode();
         }
-        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR io::Stringbuf& build_font( io::Stringbuf& buffer,
-                                                                           types::ROStr ansi_color ) const
+        __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR io::Stringbuf& build_font(
+          io::Stringbuf& buffer,
+          const console::ColorCode& ansi_color ) const
         {
           return buffer << build_color( ansi_color )
                         << ( fonts_[trait::as_val( Mask::Bolded )] ? console::escape::bold_font
@@ -2285,14 +3325,14 @@ namespace pgbar {
         __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR void member_swap( BasicAnimation& lhs ) & noexcept
         {
           std::swap( shift_factor_, lhs.shift_factor_ );
-          lead_col_.swap( lhs.lead_col_ );
+          std::swap( lead_col_, lhs.lead_col_ );
           lead_.swap( lhs.lead_ );
           std::swap( size_longest_lead_, lhs.size_longest_lead_ );
         }
 
       protected:
         types::Float shift_factor_;
-        types::String lead_col_;
+        console::ColorCode lead_col_;
         std::vector<charset::U8String> lead_;
         types::Size size_longest_lead_;
 
@@ -2387,16 +3427,16 @@ namespace pgbar {
           std::swap( bar_length_, lhs.bar_length_ );
           starting_.swap( lhs.starting_ );
           ending_.swap( lhs.ending_ );
-          start_col_.swap( lhs.start_col_ );
-          end_col_.swap( lhs.end_col_ );
-          filler_col_.swap( lhs.filler_col_ );
+          std::swap( start_col_, lhs.start_col_ );
+          std::swap( end_col_, lhs.end_col_ );
+          std::swap( filler_col_, lhs.filler_col_ );
         }
 
       protected:
         types::Size bar_length_;
         charset::U8String starting_, ending_;
-        types::String start_col_, end_col_;
-        types::String filler_col_;
+        console::ColorCode start_col_, end_col_;
+        console::ColorCode filler_col_;
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR types::Size fixed_len_bar() const noexcept
         {
@@ -2495,16 +3535,35 @@ namespace pgbar {
         }
         __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR void member_swap( CharIndicator& lhs ) & noexcept
         {
-          remains_col_.swap( lhs.remains_col_ );
+          std::swap( remains_col_, lhs.remains_col_ );
           remains_.swap( lhs.remains_ );
           filler_.swap( lhs.filler_ );
         }
 
       protected:
-        types::String remains_col_;
+        console::ColorCode remains_col_;
         charset::U8String remains_, filler_;
 
+        // Draw the filled and the remaining bar, and each lead frame in its color.
+        void cache_char( BarCache& cache ) const
+        {
+          cache.clear();
+          if ( !filler_.empty() ) {
+            cache.filler.append( filler_, this->bar_length_ / filler_.size() );
+            cache.filler_step = filler_.str().size();
+          }
+          if ( !remains_.empty() ) {
+            cache.remains.append( remains_, this->bar_length_ / remains_.size() );
+            cache.remains_step = remains_.str().size();
+          }
+          for ( const auto& lead : this->lead_ ) {
+            cache.leads << this->build_color( this->lead_col_ ) << lead << console::escape::reset_font;
+            cache.end_lead();
+          }
+        }
+
         __PGBAR_INLINE_FN __PGBAR_CXX23_CNSTXPR io::Stringbuf& build_char( io::Stringbuf& buffer,
+                                                                           const BarCache& cache,
                                                                            types::Size num_frame_cnt,
                                                                            types::Float num_percent ) const
         {
@@ -2523,7 +3582,7 @@ namespace pgbar {
             const types::Size fill_num  = len_finished / filler_.size(),
                               remaining = len_finished % filler_.size();
             len_unfinished += remaining;
-            buffer.append( filler_, fill_num );
+            cache.append_filler( buffer, fill_num );
           } else
             len_unfinished += len_finished;
           // build lead_
@@ -2534,13 +3593,13 @@ namespace pgbar {
             const auto& current_lead = this->lead_[num_frame_cnt];
             if ( current_lead.size() <= len_unfinished ) {
               len_unfinished -= current_lead.size();
-              buffer << this->build_color( this->lead_col_ ) << current_lead << console::escape::reset_font;
+              cache.append_lead( buffer, num_frame_cnt );
             }
           }
           // build remains_
           buffer << this->build_color( remains_col_ );
           if ( !this->remains_.empty() && this->remains_.size() <= len_unfinished )
-            buffer.append( remains_, len_unfinished / remains_.size() )
+            cache.append_remains( buffer, len_unfinished / remains_.size() )
               .append( constants::blank, len_unfinished % remains_.size() );
           else
             buffer.append( constants::blank, len_unfinished );
@@ -2601,7 +3660,17 @@ namespace pgbar {
       protected:
         const std::array<types::LitStr, 8> filler_ = { "▏", "▎", "▍", "▌", "▋", "▊", "▉", "█" };
 
+        // Draw the bar filled with the full blocks.
+        void cache_block( BarCache& cache ) const
+        {
+          cache.clear();
+          const types::ROStr full_block = filler_.back();
+          cache.filler.append( full_block, this->bar_length_ );
+          cache.filler_step = full_block.size();
+        }
+
         __PGBAR_INLINE_FN __PGBAR_CXX23_CNSTXPR io::Stringbuf& build_block( io::Stringbuf& buffer,
+                                                                            const BarCache& cache,
                                                                             types::Float num_percent ) const
         {
           __PGBAR_ASSERT( num_percent >= 0.0 );
@@ -2618,7 +3687,7 @@ namespace pgbar {
           const types::Size len_unfinished   = this->bar_length_ - len_finished - ( incomplete_block != 0 );
           __PGBAR_ASSERT( len_finished + len_unfinished + ( incomplete_block != 0 ) == this->bar_length_ );
 
-          return buffer.append( filler_.back(), len_finished )
+          return cache.append_filler( buffer, len_finished )
             .append( filler_[incomplete_block], incomplete_block != 0 )
             .append( console::escape::reset_font )
             .append( constants::blank, len_unfinished )
@@ -2636,19 +3705,30 @@ namespace pgbar {
       template<typename Base, typename Derived>
       class Spinner : public Base {
       protected:
+        // Draw each lead frame in its fonts, padded to the longest one.
+        void cache_spinner( BarCache& cache ) const
+        {
+          cache.clear();
+          for ( const auto& lead : this->lead_ ) {
+            __PGBAR_ASSERT( this->size_longest_lead_ >= lead.size() );
+            cache.leads << console::escape::reset_font;
+            this->build_font( cache.leads, this->lead_col_ )
+              .append( lead )
+              .append( constants::blank, this->size_longest_lead_ - lead.size() );
+            cache.end_lead();
+          }
+        }
+
         __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR io::Stringbuf& build_spinner(
           io::Stringbuf& buffer,
+          const BarCache& cache,
           types::Size num_frame_cnt ) const
         {
           if ( this->lead_.empty() )
             return buffer;
           num_frame_cnt *= this->shift_factor_;
           num_frame_cnt %= this->lead_.size();
-          __PGBAR_ASSERT( this->size_longest_lead_ >= this->lead_[num_frame_cnt].size() );
-
-          buffer << console::escape::reset_font;
-          return this->build_font( buffer, this->lead_col_ )
-              << io::formatting<io::TxtLayout::left>( this->size_longest_lead_, this->lead_[num_frame_cnt] );
+          return cache.append_lead( buffer, num_frame_cnt );
         }
 
       public:
@@ -2677,8 +3757,27 @@ namespace pgbar {
       protected:
         charset::U8String filler_;
 
+        // Draw the bar full of the filler, and each lead frame with the fonts around it.
+        void cache_scanner( BarCache& cache ) const
+        {
+          cache.clear();
+          if ( !filler_.empty() ) {
+            cache.filler.append( filler_, this->bar_length_ / filler_.size() );
+            cache.filler_step = filler_.str().size();
+          }
+          for ( const auto& lead : this->lead_ ) {
+            cache.leads.append( console::escape::reset_font )
+              .append( this->lead_col_ )
+              .append( lead )
+              .append( console::escape::reset_font )
+              .append( this->filler_col_ );
+            cache.end_lead();
+          }
+        }
+
         __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR io::Stringbuf& build_scanner(
           io::Stringbuf& buffer,
+          const BarCache& cache,
           types::Size num_frame_cnt ) const
         {
           num_frame_cnt *= this->shift_factor_;
@@ -2686,7 +3785,8 @@ namespace pgbar {
                  << console::escape::reset_font << this->build_color( this->filler_col_ );
 
           if ( !this->lead_.empty() ) {
-            const auto& current_lead = this->lead_[num_frame_cnt % this->lead_.size()];
+            const auto idx_lead      = num_frame_cnt % this->lead_.size();
+            const auto& current_lead = this->lead_[idx_lead];
             if ( current_lead.size() <= this->bar_length_ ) {
               const auto len_left = [this, num_frame_cnt, &current_lead]() noexcept -> types::Size {
                 const types::Size period = ( this->bar_length_ - current_lead.size() - 1 ) * 2;
@@ -2697,21 +3797,21 @@ namespace pgbar {
               const types::Size len_right = this->bar_length_ - current_lead.size() - len_left - 1;
               __PGBAR_ASSERT( len_left + len_right + current_lead.size() == this->bar_length_ );
 
-              buffer.append( filler_, len_left / filler_.size() )
-                .append( constants::blank, len_left % filler_.size() )
-                .append( console::escape::reset_font )
-                .append( this->lead_col_ )
-                .append( current_lead )
-                .append( console::escape::reset_font )
-                .append( this->filler_col_ )
-                .append( constants::blank, len_right % filler_.size() )
-                .append( filler_, len_right / filler_.size() );
+              if ( filler_.empty() )
+                cache.append_lead( buffer.append( constants::blank, len_left ), idx_lead )
+                  .append( constants::blank, len_right );
+              else {
+                cache.append_filler( buffer, len_left / filler_.size() )
+                  .append( constants::blank, len_left % filler_.size() );
+                cache.append_lead( buffer, idx_lead ).append( constants::blank, len_right % filler_.size() );
+                cache.append_filler( buffer, len_right / filler_.size() );
+              }
             } else
               buffer.append( constants::blank, this->bar_length_ );
           } else if ( filler_.empty() )
             buffer.append( constants::blank, this->bar_length_ );
           else
-            buffer.append( filler_, this->bar_length_ / filler_.size() )
+            cache.append_filler( buffer, this->bar_length_ / filler_.size() )
               .append( constants::blank, this->bar_length_ % filler_.size() );
 
           return buffer << console::escape::reset_font << this->build_color( this->end_col_ )
@@ -2766,18 +3866,18 @@ namespace pgbar {
         }
         __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR void member_swap( Description& lhs ) & noexcept
         {
-          desc_col_.swap( lhs.desc_col_ );
-          true_col_.swap( lhs.true_col_ );
-          false_col_.swap( lhs.false_col_ );
+          std::swap( desc_col_, lhs.desc_col_ );
+          std::swap( true_col_, lhs.true_col_ );
+          std::swap( false_col_, lhs.false_col_ );
           description_.swap( lhs.description_ );
           true_mesg_.swap( lhs.true_mesg_ );
           false_mesg_.swap( lhs.false_mesg_ );
         }
 
       protected:
-        types::String desc_col_;
-        types::String true_col_;
-        types::String false_col_;
+        console::ColorCode desc_col_;
+        console::ColorCode true_col_;
+        console::ColorCode false_col_;
 
         charset::U8String description_;
         charset::U8String true_mesg_;
@@ -2899,14 +3999,14 @@ namespace pgbar {
         }
         __PGBAR_INLINE_FN __PGBAR_CXX20_CNSTXPR void member_swap( Segment& lhs ) & noexcept
         {
-          info_col_.swap( lhs.info_col_ );
+          std::swap( info_col_, lhs.info_col_ );
           divider_.swap( lhs.divider_ );
           l_border_.swap( lhs.l_border_ );
           r_border_.swap( lhs.r_border_ );
         }
 
       protected:
-        types::String info_col_;
+        console::ColorCode info_col_;
         charset::U8String divider_;
         charset::U8String l_border_, r_border_;
 
@@ -3002,17 +4102,21 @@ namespace pgbar {
         constexpr static types::Size _fixed_length = sizeof( __PGBAR_DEFAULT_PERCENT ) - 1;
 
       protected:
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::String build_percent( types::Float num_percent ) const
+        __PGBAR_INLINE_FN io::Stringbuf& build_percent( io::Stringbuf& buffer,
+                                                        types::Float num_percent ) const
         {
           __PGBAR_ASSERT( num_percent >= 0.0 );
           __PGBAR_ASSERT( num_percent <= 1.0 );
 
-          __PGBAR_UNLIKELY if ( num_percent <= 0.0 ) return { __PGBAR_DEFAULT_PERCENT };
+          __PGBAR_UNLIKELY if ( num_percent <= 0.0 ) return buffer << __PGBAR_DEFAULT_PERCENT;
 
-          auto proportion = std::to_string( num_percent * 100.0 );
-          proportion.resize( proportion.find( '.' ) + 3 );
-
-          return io::formatting<io::TxtLayout::right>( _fixed_length, std::move( proportion ) + "%" );
+          // Rounded to six decimal places of the percentage first, then truncated to two.
+          const auto hundredths = static_cast<std::uint64_t>( std::round( num_percent * 1e8 ) ) / 10000;
+          // Leave room for the point, two decimal places and the percent sign.
+          return buffer.append_number( hundredths / 100, _fixed_length - 4 )
+            .append( '.' )
+            .append_number( hundredths % 100, 2, '0' )
+            .append( '%' );
         }
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr types::Size fixed_len_percent() const noexcept
@@ -3054,40 +4158,53 @@ namespace pgbar {
         std::array<charset::U8String, 4> units_;
         types::Size longest_unit_;
 
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::String build_speed( const types::TimeUnit& time_passed,
-                                                                       types::Size num_task_done,
-                                                                       types::Size num_all_tasks ) const
+        __PGBAR_INLINE_FN io::Stringbuf& build_speed( io::Stringbuf& buffer,
+                                                      const types::TimeUnit& time_passed,
+                                                      types::Size num_task_done,
+                                                      types::Size num_all_tasks ) const
         {
           __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          __PGBAR_UNLIKELY if ( num_all_tasks == 0 ) return io::formatting<io::TxtLayout::right>(
-            _fixed_length + longest_unit_,
-            "-- " + units_.front() );
-
-          const auto float2string = []( types::Float val ) -> types::String {
-            auto str = std::to_string( std::round( val * 100.0 ) / 100.0 );
-            str.resize( str.find( '.' ) + 3 ); // Keep two decimal places.
-            str.append( 1, constants::blank );
-            return str;
-          };
+          const auto width = _fixed_length + longest_unit_;
+          __PGBAR_UNLIKELY if ( num_all_tasks == 0 )
+          {
+            buffer.append( constants::blank, width - 3 - units_.front().size() );
+            return buffer << "-- " << units_.front();
+          }
 
           const auto seconds_passed    = std::chrono::duration<types::Float>( time_passed ).count();
           // zero or negetive is invalid
           const types::Float frequency = seconds_passed <= 0.0 ? ( std::numeric_limits<types::Float>::max )()
                                                                : num_task_done / seconds_passed;
-          types::String rate_str;
+          types::Float rate = frequency;
+          types::Size unit  = 0;
           if ( frequency < 1e3 ) // < 1 Hz => '999.99 Hz'
-            rate_str = float2string( frequency ) + units_[0];
-          else if ( frequency < 1e6 ) // < 1 kHz => '999.99 kHz'
-            rate_str = float2string( frequency / 1e3 ) + units_[1];
-          else if ( frequency < 1e9 ) // < 1 MHz => '999.99 MHz'
-            rate_str = float2string( frequency / 1e6 ) + units_[2];
-          else { // > 999 GHz => infinity
-            const types::Float remains                        = frequency / 1e9;
-            __PGBAR_UNLIKELY if ( remains > 999.99 ) rate_str = __PGBAR_DEFAULT_SPEED + units_[0];
-            else rate_str                                     = float2string( remains ) + units_[3];
+            ;
+          else if ( frequency < 1e6 ) { // < 1 kHz => '999.99 kHz'
+            rate = frequency / 1e3;
+            unit = 1;
+          } else if ( frequency < 1e9 ) { // < 1 MHz => '999.99 MHz'
+            rate = frequency / 1e6;
+            unit = 2;
+          } else { // > 999 GHz => infinity
+            rate = frequency / 1e9;
+            unit = 3;
+            __PGBAR_UNLIKELY if ( rate > 999.99 )
+            {
+              buffer.append( constants::blank, longest_unit_ - units_[0].size() );
+              return buffer << __PGBAR_DEFAULT_SPEED << units_[0];
+            }
           }
 
-          return io::formatting<io::TxtLayout::right>( _fixed_length + longest_unit_, rate_str );
+          // Keep two decimal places.
+          const auto hundredths = static_cast<std::uint64_t>( std::round( rate * 100.0 ) );
+          // The integral part, the point, two decimal places, a blank and the unit.
+          const auto length     = io::count_digits( hundredths / 100 ) + 4 + units_[unit].size();
+          return buffer.append( constants::blank, width > length ? width - length : 0 )
+            .append_number( hundredths / 100 )
+            .append( '.' )
+            .append_number( hundredths % 100, 2, '0' )
+            .append( constants::blank )
+            .append( units_[unit] );
         }
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr types::Size fixed_len_speed() const noexcept
@@ -3133,16 +4250,16 @@ namespace pgbar {
       template<typename Base, typename Derived>
       class CounterMeter : public Base {
       protected:
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::String build_counter( types::Size num_task_done,
-                                                                         types::Size num_all_tasks ) const
+        __PGBAR_INLINE_FN io::Stringbuf& build_counter( io::Stringbuf& buffer,
+                                                        types::Size num_task_done,
+                                                        types::Size num_all_tasks ) const
         {
           __PGBAR_ASSERT( num_task_done <= num_all_tasks );
           if ( num_all_tasks == 0 )
-            return { "-/-" };
-          types::String total_str = std::to_string( num_all_tasks );
-          const types::Size size  = total_str.size();
-          return io::formatting<io::TxtLayout::right>( size, std::to_string( num_task_done ) ) + "/"
-               + std::move( total_str );
+            return buffer << "-/-";
+          return buffer.append_number( num_task_done, io::count_digits( num_all_tasks ) )
+            .append( '/' )
+            .append_number( num_all_tasks );
         }
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size fixed_len_counter() const noexcept
@@ -3166,21 +4283,24 @@ namespace pgbar {
 # define __PGBAR_DEFAULT_TIMER "--:--:--"
 
       protected:
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::String time_formatter( types::TimeUnit duration ) const
+        __PGBAR_INLINE_FN io::Stringbuf& time_formatter( io::Stringbuf& buffer,
+                                                         types::TimeUnit duration ) const
         {
-          const auto time2str = []( std::int64_t num_time ) -> types::String {
-            auto ret = std::to_string( num_time );
-            if ( ret.size() < 2 )
-              return "0" + std::move( ret );
-            return ret;
-          };
+          // A clock going backwards is shown as no time passed.
+          if ( duration.count() < 0 )
+            duration = types::TimeUnit::zero();
           const auto hours = std::chrono::duration_cast<std::chrono::hours>( duration );
           duration -= hours;
           const auto minutes = std::chrono::duration_cast<std::chrono::minutes>( duration );
           duration -= minutes;
-          return ( ( ( hours.count() > 99 ? types::String( "--" ) : time2str( hours.count() ) ) + ":" )
-                   + ( time2str( minutes.count() ) + ":" )
-                   + time2str( std::chrono::duration_cast<std::chrono::seconds>( duration ).count() ) );
+          if ( hours.count() > 99 )
+            buffer << "--";
+          else
+            buffer.append_number( hours.count(), 2, '0' );
+          return buffer.append( ':' )
+            .append_number( minutes.count(), 2, '0' )
+            .append( ':' )
+            .append_number( std::chrono::duration_cast<std::chrono::seconds>( duration ).count(), 2, '0' );
         }
 
       public:
@@ -3192,9 +4312,10 @@ namespace pgbar {
       template<typename Base, typename Derived>
       class ElapsedTimer : public Base {
       protected:
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::String build_elapsed( types::TimeUnit time_passed ) const
+        __PGBAR_INLINE_FN io::Stringbuf& build_elapsed( io::Stringbuf& buffer,
+                                                        types::TimeUnit time_passed ) const
         {
-          return this->time_formatter( std::move( time_passed ) );
+          return this->time_formatter( buffer, std::move( time_passed ) );
         }
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr types::Size fixed_len_elapsed() const noexcept
@@ -3211,13 +4332,14 @@ namespace pgbar {
       template<typename Base, typename Derived>
       class CountdownTimer : public Base {
       protected:
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::String build_countdown( const types::TimeUnit& time_passed,
-                                                                           types::Size num_task_done,
-                                                                           types::Size num_all_tasks ) const
+        __PGBAR_INLINE_FN io::Stringbuf& build_countdown( io::Stringbuf& buffer,
+                                                          const types::TimeUnit& time_passed,
+                                                          types::Size num_task_done,
+                                                          types::Size num_all_tasks ) const
         {
           __PGBAR_ASSERT( num_task_done <= num_all_tasks );
           if ( num_task_done == 0 || num_all_tasks == 0 )
-            return { __PGBAR_DEFAULT_TIMER };
+            return buffer << __PGBAR_DEFAULT_TIMER;
 
           auto time_per_task = time_passed / num_task_done;
           if ( time_per_task.count() == 0 )
@@ -3226,9 +4348,9 @@ namespace pgbar {
           const auto remaining_tasks = num_all_tasks - num_task_done;
           // overflow check
           if ( remaining_tasks > std::numeric_limits<std::int64_t>::max() / time_per_task.count() )
-            return { __PGBAR_DEFAULT_TIMER };
+            return buffer << __PGBAR_DEFAULT_TIMER;
           else
-            return this->time_formatter( time_per_task * remaining_tasks );
+            return this->time_formatter( buffer, time_per_task * remaining_tasks );
         }
 
         __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr types::Size fixed_len_countdown() const noexcept
@@ -3468,6 +4590,156 @@ namespace pgbar {
           for ( auto&& e : iterate( container ) )
             unary_fn( std::forward<decltype( e )>( e ) );
         }
+
+      private:
+        template<typename Accessor, typename F>
+        void parallel_run( types::Size num_tasks, Accessor&& accessor, F& unary_fn, types::Size num_threads )
+        {
+          auto& bar = static_cast<Derived&>( *this );
+          bar.config().tasks( num_tasks );
+          if ( num_tasks == 0 )
+            return;
+
+          if ( num_threads == 0 )
+            num_threads = std::thread::hardware_concurrency();
+          num_threads = std::max<types::Size>( std::min( num_threads, num_tasks ), 1 );
+          // Small enough to balance the load, large enough to make the progress report cheap.
+          const auto grain =
+            std::max<types::Size>( std::min<types::Size>( num_tasks / ( num_threads * 64 ), 1 << 14 ), 1 );
+
+          // Each worker reports its progress in batches, the bar is ticked about 64 times per worker.
+          const auto batch = std::max<types::Size>( num_tasks / ( num_threads * 64 ), 1 );
+
+          concurrent::WorkStealer stealer { num_tasks, num_threads };
+          concurrent::ExceptionBox box;
+          concurrent::Mutex tick_mtx; // Only taken if the bar itself is thread-unsafe.
+          std::atomic<bool> aborted { false };
+
+          auto report = [&]( types::Size num_done ) {
+            std::unique_lock<concurrent::Mutex> lock { tick_mtx, std::defer_lock };
+            if ( trait::is_threadunsafe_bar<Derived>::value )
+              lock.lock();
+            bar.tick( num_done );
+          };
+          auto worker = [&]( types::Size id ) noexcept {
+            try {
+              types::Size first = 0, last = 0, pending = 0;
+              while ( !aborted.load( std::memory_order_relaxed ) && stealer.take( id, grain, first, last ) ) {
+                for ( auto i = first; i < last; ++i )
+                  unary_fn( accessor( i ) );
+                pending += last - first;
+                if ( pending >= batch ) {
+                  report( pending );
+                  pending = 0;
+                }
+              }
+              if ( pending != 0 )
+                report( pending );
+            } catch ( ... ) {
+              box.store( std::current_exception() );
+              aborted.store( true, std::memory_order_relaxed );
+            }
+          };
+
+          using Worker = decltype( worker );
+          bool pooled  = false;
+          std::vector<std::thread> workers;
+          try {
+            if ( num_threads > 1 )
+              pooled = concurrent::WorkerPool::instance().try_start(
+                num_threads - 1,
+                []( void* context, types::Size id ) { ( *static_cast<Worker*>( context ) )( id ); },
+                std::addressof( worker ) );
+            if ( !pooled ) {
+              workers.reserve( num_threads - 1 );
+              for ( types::Size id = 1; id < num_threads; ++id )
+                workers.emplace_back( worker, id );
+            }
+          } catch ( ... ) {
+            box.store( std::current_exception() );
+            aborted.store( true, std::memory_order_relaxed );
+          }
+          worker( 0 ); // The current thread is also a worker.
+          if ( pooled )
+            concurrent::WorkerPool::instance().wait();
+          for ( auto& td : workers )
+            td.join();
+          box.rethrow();
+        }
+
+      public:
+        /**
+         * Apply `unary_fn` to every element of the range with `num_threads` threads,
+         * including the current one; `num_threads` defaults to the number of hardware threads.
+         *
+         * The range is split into chunks that idle threads steal from busy ones,
+         * and each thread reports its progress in batches.
+         * The threads are parked and reused by later calls, unless another call is still using them.
+         * `unary_fn` must be safe to call concurrently; the first exception it throws stops the iteration,
+         * and is rethrown after all threads have finished.
+         */
+        template<typename N, typename F>
+        void parallel_iterate( const iterators::NumericSpan<N>& range,
+                               F&& unary_fn,
+                               types::Size num_threads = 0 )
+        {
+          const auto start = range.start_value();
+          const auto step  = range.step();
+          parallel_run(
+            range.size(),
+            [start, step]( types::Size index ) noexcept -> N {
+              return *typename iterators::NumericSpan<N>::iterator( start, step, index );
+            },
+            unary_fn,
+            num_threads );
+        }
+        // Only available for random access iterators.
+        template<typename I, typename F>
+        void parallel_iterate( iterators::IterSpan<I> range, F&& unary_fn, types::Size num_threads = 0 )
+        {
+          static_assert( std::is_base_of<std::random_access_iterator_tag,
+                                         typename std::iterator_traits<I>::iterator_category>::value,
+                         "pgbar::__detail::asset::TaskCounter::parallel_iterate: Only available for random "
+                         "access iterators" );
+          const I start = range.start_iter();
+          // A pointer range may be reversed.
+          const bool reversed = std::is_pointer<I>::value && range.end_iter() < start;
+          parallel_run(
+            range.size(),
+            [start, reversed]( types::Size index ) -> typename std::iterator_traits<I>::reference {
+              using Diff = typename std::iterator_traits<I>::difference_type;
+              return reversed ? *( start - static_cast<Diff>( index ) )
+                              : *( start + static_cast<Diff>( index ) );
+            },
+            unary_fn,
+            num_threads );
+        }
+        template<class R, typename F>
+# if __PGBAR_CXX20
+          requires std::disjunction_v<std::is_class<std::decay_t<R>>,
+                                      std::is_array<std::remove_reference_t<R>>>
+                && std::is_lvalue_reference_v<R> && ( !trait::is_arith_range<std::decay_t<R>>::value )
+                && ( !trait::is_iter_range<std::decay_t<R>>::value )
+        void
+# else
+        typename std::enable_if<( std::is_class<typename std::decay<R>::type>::value
+                                  || std::is_array<typename std::remove_reference<R>::type>::value )
+                                && std::is_lvalue_reference<R>::value
+                                && !trait::is_arith_range<typename std::decay<R>::type>::value
+                                && !trait::is_iter_range<typename std::decay<R>::type>::value>::type
+# endif
+          parallel_iterate( R&& container, F&& unary_fn, types::Size num_threads = 0 )
+        {
+# if __PGBAR_CXX20
+          auto range = iterators::IterSpan<trait::IteratorTrait_t<R>>( std::ranges::begin( container ),
+                                                                        std::ranges::end( container ) );
+# else
+          using std::begin;
+          using std::end; // for ADL
+          auto range = iterators::IterSpan<trait::IteratorTrait_t<R>>( begin( container ), end( container ) );
+# endif
+          parallel_iterate( std::move( range ), unary_fn, num_threads );
+        }
       };
       template<typename Base, typename Derived>
       __PGBAR_CXX20_CNSTXPR TaskCounter<Base, Derived>::~TaskCounter() noexcept = default;
@@ -3552,55 +4824,154 @@ namespace pgbar {
   } // namespace __detail
 
   namespace config {
+    /**
+     * How the render thread shared by all bars is placed and scheduled.
+     * Settings that the platform doesn't support are ignored, and so are the failed ones.
+     */
+    struct RenderThread {
+      // The CPUs the thread may run on; if empty, the thread keeps the affinity it inherited.
+      std::vector<std::size_t> cpus;
+      /**
+       * Run the thread only when the CPUs have nothing else to do: `SCHED_IDLE` or `THREAD_PRIORITY_IDLE`;
+       * if false, the thread keeps the policy and priority it inherited.
+       */
+      bool idle = false;
+      // The nice value of the thread unless it's idle, zero keeps the inherited one; Linux only.
+      int niceness = 0;
+      // Shown by tools like `top -H`, at most 15 bytes are kept; Linux only.
+      std::string name = "pgbar";
+      // The stack size of the thread in bytes, zero keeps the system default; Unix only.
+      std::size_t stack_size = 0;
+    };
+
     class Core {
       static const bool _stdout_in_tty;
       static const bool _stderr_in_tty;
 
-      static __detail::types::TimeUnit _refresh_interval;
-      static __detail::concurrent::SharedMutex _rw_mtx;
+      // Stored as a count of `TimeUnit` ticks, so that reading it on every frame takes no lock.
+      static std::atomic<__detail::types::TimeUnit::rep> _refresh_interval;
+
+      static std::atomic<bool> _keep_alive;
+
+      static std::atomic<std::chrono::steady_clock::time_point ( * )()> _clock;
+
+      // The interval of this bar, zero if it follows the global one.
+      std::atomic<__detail::types::TimeUnit::rep> interval_;
 
     public:
-      using TimeUnit = __detail::types::TimeUnit;
+      using TimeUnit  = __detail::types::TimeUnit;
+      using TimePoint = std::chrono::steady_clock::time_point;
+      // A source of time for the bars, which must neither throw nor go backwards.
+      using Clock = TimePoint ( * )();
+
+      // Read `std::chrono::steady_clock`, the default clock.
+      __PGBAR_NODISCARD static TimePoint steady_now() noexcept { return std::chrono::steady_clock::now(); }
+      /**
+       * Read `CLOCK_MONOTONIC_COARSE` on Linux, which is cheaper to read than `steady_clock`,
+       * but only advances once every few milliseconds; elsewhere it's the same as `steady_now()`.
+       */
+      __PGBAR_NODISCARD static TimePoint coarse_now() noexcept
+      {
+# if defined( __linux__ ) && defined( CLOCK_MONOTONIC_COARSE )
+        timespec spec;
+        __PGBAR_UNLIKELY if ( clock_gettime( CLOCK_MONOTONIC_COARSE, &spec ) != 0 ) return steady_now();
+        // Both clocks count from the same point as `steady_clock` is based on `CLOCK_MONOTONIC` there.
+        return TimePoint( std::chrono::duration_cast<TimePoint::duration>(
+          std::chrono::seconds( spec.tv_sec ) + std::chrono::nanoseconds( spec.tv_nsec ) ) );
+# else
+        return steady_now();
+# endif
+      }
+
+      // Get the current time from the clock of the bars.
+      __PGBAR_NODISCARD static TimePoint now() noexcept { return _clock.load( std::memory_order_relaxed )(); }
+      // Get the clock that times the bars.
+      __PGBAR_NODISCARD static Clock clock() noexcept { return _clock.load( std::memory_order_relaxed ); }
+      /**
+       * Replace the clock that times the bars: their elapsed time, speed and countdown,
+       * as well as when their frames are drawn; passing `nullptr` restores `steady_now()`.
+       *
+       * It should be replaced while no bar is running, since the running ones keep the time they started at.
+       */
+      static void clock( Clock new_clock ) noexcept
+      {
+        _clock.store( new_clock != nullptr ? new_clock : &steady_now, std::memory_order_relaxed );
+      }
 
       // Get the current output interval.
-      __PGBAR_NODISCARD static TimeUnit refresh_interval()
+      __PGBAR_NODISCARD static TimeUnit refresh_interval() noexcept
       {
-        __detail::concurrent::SharedMutexRef shared_end { _rw_mtx };
-        std::lock_guard<__detail::concurrent::SharedMutexRef> lock { shared_end };
-        return _refresh_interval;
+        return TimeUnit( _refresh_interval.load( std::memory_order_relaxed ) );
       }
       // Set the new output interval.
-      static void refresh_interval( TimeUnit new_rate )
+      static void refresh_interval( TimeUnit new_rate ) noexcept
+      {
+        _refresh_interval.store( new_rate.count(), std::memory_order_relaxed );
+      }
+      /**
+       * Decide whether the render thread shared by all bars stays parked while no bar is running,
+       * which is the default; otherwise it exits once the last running bar stops,
+       * and the next bar that starts creates it again.
+       */
+      static inline void keep_alive( bool keep ) noexcept;
+      // Check whether the render thread is kept alive while no bar is running.
+      __PGBAR_NODISCARD static bool keep_alive() noexcept
       {
-        std::lock_guard<__detail::concurrent::SharedMutex> lock { _rw_mtx };
-        _refresh_interval = std::move( new_rate );
+        return _keep_alive.load( std::memory_order_acquire );
       }
+      /**
+       * Set how the render thread is placed and scheduled, which takes effect at once;
+       * the stack size is only used from the next time the thread is created.
+       */
+      static inline void render_thread( RenderThread settings );
+      // Get the settings of the render thread.
+      __PGBAR_NODISCARD static inline RenderThread render_thread();
+
       __PGBAR_NODISCARD __PGBAR_INLINE_FN static bool intty( StreamChannel stream_type ) noexcept
       {
         return stream_type == StreamChannel::Stdout ? _stdout_in_tty : _stderr_in_tty;
       }
 
-      constexpr Core() noexcept              = default;
-      constexpr Core( const Core& ) noexcept = default;
-      constexpr Core( Core&& ) noexcept      = default;
-      __PGBAR_CXX17_CNSTXPR Core& operator=( const Core& lhs ) &
+      /**
+       * Get the output interval of this bar,
+       * which is the global one unless the bar has been given its own.
+       */
+      __PGBAR_NODISCARD TimeUnit interval() const noexcept
+      {
+        const auto own = interval_.load( std::memory_order_relaxed );
+        return own > 0 ? TimeUnit( own ) : refresh_interval();
+      }
+      /**
+       * Set the output interval of this bar, it takes effect from the next frame on.
+       * Passing zero makes the bar follow the global interval again.
+       */
+      void interval( TimeUnit new_rate ) & noexcept
+      {
+        interval_.store( new_rate.count() > 0 ? new_rate.count() : 0, std::memory_order_relaxed );
+      }
+
+      constexpr Core() noexcept : interval_ { 0 } {}
+      Core( const Core& lhs ) noexcept : interval_ { lhs.interval_.load( std::memory_order_relaxed ) } {}
+      Core( Core&& rhs ) noexcept : Core( rhs ) {}
+      Core& operator=( const Core& lhs ) & noexcept
       {
         __PGBAR_ASSERT( this != std::addressof( lhs ) );
-        (void)lhs;
+        interval_.store( lhs.interval_.load( std::memory_order_relaxed ), std::memory_order_relaxed );
         return *this;
       }
-      __PGBAR_CXX17_CNSTXPR Core& operator=( Core&& rhs ) & noexcept
+      Core& operator=( Core&& rhs ) & noexcept
       {
         __PGBAR_ASSERT( this != std::addressof( rhs ) );
-        (void)rhs;
-        return *this;
+        return operator=( rhs );
       }
 
       __PGBAR_CXX20_CNSTXPR virtual ~Core() noexcept = 0;
     };
-    Core::TimeUnit Core::_refresh_interval =
-      std::chrono::duration_cast<Core::TimeUnit>( std::chrono::milliseconds( 40 ) );
-    __detail::concurrent::SharedMutex Core::_rw_mtx {};
+    std::atomic<Core::TimeUnit::rep> Core::_refresh_interval {
+      std::chrono::duration_cast<Core::TimeUnit>( std::chrono::milliseconds( 40 ) ).count()
+    };
+    std::atomic<bool> Core::_keep_alive { true };
+    std::atomic<Core::Clock> Core::_clock { &Core::steady_now };
     const bool Core::_stdout_in_tty              = __detail::console::intty<StreamChannel::Stdout>();
     const bool Core::_stderr_in_tty              = __detail::console::intty<StreamChannel::Stderr>();
     __PGBAR_CXX20_CNSTXPR Core::~Core() noexcept = default;
@@ -3875,82 +5246,272 @@ namespace pgbar {
         }
       };
 
-      template<typename ConfigType>
-      struct CommonBuilder : public ConfigType {
-        using ConfigType::ConfigType;
-        CommonBuilder( const ConfigType& config )
-          noexcept( std::is_nothrow_copy_constructible<ConfigType>::value )
-          : ConfigType( config )
-        {}
-        CommonBuilder( ConfigType&& config ) noexcept( std::is_nothrow_move_constructible<ConfigType>::value )
-          : ConfigType( std::move( config ) )
-        {}
-        virtual ~CommonBuilder() noexcept = default;
-
-        /**
-         * Builds and only builds the components belows:
-         * `CounterMeter`, `SpeedMeter`, `ElapsedTimer` and `CountdownTimer`
-         */
-        __PGBAR_INLINE_FN io::Stringbuf& common_build(
-          io::Stringbuf& buffer,
-          types::Size num_task_done,
-          types::Size num_all_tasks,
-          const std::chrono::steady_clock::time_point& zero_point ) const
+      // The parts of a frame that change from one frame to another.
+      enum class Slot : types::BitwiseSet { percent, animation, counter, speed, elapsed, countdown };
+
+      // What a frame shows, apart from what the config decides.
+      struct FrameData {
+        types::Size num_frame_cnt;
+        types::Size num_task_done;
+        types::Size num_all_tasks;
+        types::Float num_percent;
+        types::TimeUnit time_passed;
+
+        FrameData( types::Size frame_cnt,
+                   types::Size task_done,
+                   types::Size all_tasks,
+                   const std::chrono::steady_clock::time_point& zero_point ) noexcept
+          : num_frame_cnt { frame_cnt }
+          , num_task_done { task_done }
+          , num_all_tasks { all_tasks }
+          , num_percent { static_cast<types::Float>( task_done ) / all_tasks }
+          , time_passed { config::Core::now() - zero_point }
         {
           __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          using self = ConfigType;
-          if ( this->visual_masks_[trait::as_val( self::Mask::Cnt )]
-               || this->visual_masks_[trait::as_val( self::Mask::Sped )]
-               || this->visual_masks_[trait::as_val( self::Mask::Elpsd )]
-               || this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] ) {
-            buffer << console::escape::reset_font;
-            this->build_font( buffer, this->info_col_ );
-            if ( this->visual_masks_[trait::as_val( self::Mask::Cnt )] ) {
-              buffer << this->build_counter( num_task_done, num_all_tasks );
-              if ( this->visual_masks_[trait::as_val( self::Mask::Sped )]
-                   || this->visual_masks_[trait::as_val( self::Mask::Elpsd )]
-                   || this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] )
-                this->build_divider( buffer );
-            }
-            const auto time_passed = std::chrono::steady_clock::now() - zero_point;
-            if ( this->visual_masks_[trait::as_val( self::Mask::Sped )] ) {
-              buffer << this->build_speed( time_passed, num_task_done, num_all_tasks );
-              if ( this->visual_masks_[trait::as_val( self::Mask::Elpsd )]
-                   || this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] )
-                this->build_divider( buffer );
-            }
-            if ( this->visual_masks_[trait::as_val( self::Mask::Elpsd )] ) {
-              buffer << this->build_elapsed( time_passed );
-              if ( this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] )
-                buffer << " < ";
-            }
-            if ( this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] )
-              buffer << this->build_countdown( time_passed, num_task_done, num_all_tasks );
-          }
-          return buffer;
+        }
+      };
+
+      /**
+       * Whether the calling thread is the render thread, which is the only one that builds frames;
+       * that is what lets a config refresh its caches while it's only locked for reading.
+       */
+      __PGBAR_NODISCARD inline bool& on_render_thread() noexcept
+      {
+        static thread_local bool flag = false;
+        return flag;
+      }
+
+      /**
+       * A frame compiled from the config: the bytes that only change with the config,
+       * and the positions of the slots between them that are filled on every frame.
+       *
+       * A copy starts out empty, since it belongs to another config.
+       */
+      class FrameProgram final {
+        io::Stringbuf statics_;
+        std::vector<std::pair<types::Size, Slot>> slots_;
+        // The generation of the config it was compiled from.
+        types::Size generation_;
+        bool compiled_;
+
+      public:
+        FrameProgram() noexcept : generation_ { 0 }, compiled_ { false } {}
+        FrameProgram( const FrameProgram& ) noexcept : FrameProgram() {}
+        FrameProgram& operator=( const FrameProgram& ) & noexcept
+        {
+          compiled_ = false;
+          return *this;
+        }
+        ~FrameProgram() noexcept = default;
+
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN bool stale( types::Size generation ) const noexcept
+        {
+          return !compiled_ || generation_ != generation;
+        }
+        // Drop the old program, the static bytes of the new one are written to the returned buffer.
+        __PGBAR_INLINE_FN io::Stringbuf& recompile() & noexcept
+        {
+          compiled_ = false;
+          statics_.clear();
+          slots_.clear();
+          return statics_;
+        }
+        __PGBAR_INLINE_FN void mark( Slot slot ) & { slots_.emplace_back( statics_.size(), slot ); }
+        __PGBAR_INLINE_FN void commit( types::Size generation ) & noexcept
+        {
+          generation_ = generation;
+          compiled_   = true;
+        }
+
+        // Copy the static bytes to `buffer`, and let `fill` write each slot.
+        template<typename F>
+        __PGBAR_INLINE_FN io::Stringbuf& run( io::Stringbuf& buffer, F&& fill ) const
+        {
+          __PGBAR_ASSERT( compiled_ );
+          types::Size offset = 0;
+          for ( const auto& slot : slots_ ) {
+            buffer.append( statics_.data() + offset, statics_.data() + slot.first );
+            offset = slot.first;
+            fill( buffer, slot.second );
+          }
+          return buffer.append( statics_.data() + offset, statics_.data() + statics_.size() );
+        }
+      };
+
+      // A size derived from the config, kept until the config is changed; a copy starts out empty.
+      class CachedSize final {
+        types::Size size_;
+        types::Size generation_;
+        bool cached_;
+
+      public:
+        CachedSize() noexcept : size_ { 0 }, generation_ { 0 }, cached_ { false } {}
+        CachedSize( const CachedSize& ) noexcept : CachedSize() {}
+        CachedSize& operator=( const CachedSize& ) & noexcept
+        {
+          cached_ = false;
+          return *this;
+        }
+        ~CachedSize() noexcept = default;
+
+        template<typename F>
+        __PGBAR_INLINE_FN types::Size get( types::Size generation, F&& compute ) &
+        {
+          __PGBAR_UNLIKELY if ( !cached_ || generation_ != generation )
+          {
+            size_       = compute();
+            generation_ = generation;
+            cached_     = true;
+          }
+          return size_;
         }
       };
 
       template<typename ConfigType>
       struct Builder;
+      template<typename ConfigType>
+      struct CommonBuilder : public ConfigType {
+      private:
+        /* Only used by the render thread, with the config locked for reading;
+         * a writer holds the exclusive lock, so nothing else touches them while they're refreshed. */
+        mutable FrameProgram program_;
+        mutable asset::BarCache cache_;
+        // Only used by the render thread.
+        mutable CachedSize full_size_;
+
+      public:
+        using ConfigType::ConfigType;
+        CommonBuilder( const ConfigType& config )
+          noexcept( std::is_nothrow_copy_constructible<ConfigType>::value )
+          : ConfigType( config )
+        {}
+        CommonBuilder( ConfigType&& config ) noexcept( std::is_nothrow_move_constructible<ConfigType>::value )
+          : ConfigType( std::move( config ) )
+        {}
+        virtual ~CommonBuilder() noexcept = default;
+
+        /**
+         * Lays out and only lays out the components belows:
+         * `CounterMeter`, `SpeedMeter`, `ElapsedTimer` and `CountdownTimer`
+         */
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& common_layout( io::Stringbuf& buffer, Sink& sink ) const
+        {
+          using self = ConfigType;
+          if ( this->visual_masks_[trait::as_val( self::Mask::Cnt )]
+               || this->visual_masks_[trait::as_val( self::Mask::Sped )]
+               || this->visual_masks_[trait::as_val( self::Mask::Elpsd )]
+               || this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] ) {
+            buffer << console::escape::reset_font;
+            this->build_font( buffer, this->info_col_ );
+            if ( this->visual_masks_[trait::as_val( self::Mask::Cnt )] ) {
+              sink( buffer, Slot::counter );
+              if ( this->visual_masks_[trait::as_val( self::Mask::Sped )]
+                   || this->visual_masks_[trait::as_val( self::Mask::Elpsd )]
+                   || this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] )
+                this->build_divider( buffer );
+            }
+            if ( this->visual_masks_[trait::as_val( self::Mask::Sped )] ) {
+              sink( buffer, Slot::speed );
+              if ( this->visual_masks_[trait::as_val( self::Mask::Elpsd )]
+                   || this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] )
+                this->build_divider( buffer );
+            }
+            if ( this->visual_masks_[trait::as_val( self::Mask::Elpsd )] ) {
+              sink( buffer, Slot::elapsed );
+              if ( this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] )
+                buffer << " < ";
+            }
+            if ( this->visual_masks_[trait::as_val( self::Mask::Cntdwn )] )
+              sink( buffer, Slot::countdown );
+          }
+          return buffer;
+        }
+
+        // Fill the slots shared by all bars.
+        __PGBAR_INLINE_FN io::Stringbuf& fill_meter( io::Stringbuf& buffer,
+                                                     Slot slot,
+                                                     const FrameData& frame ) const
+        {
+          switch ( slot ) {
+          case Slot::percent: return this->build_percent( buffer, frame.num_percent );
+          case Slot::counter: return this->build_counter( buffer, frame.num_task_done, frame.num_all_tasks );
+          case Slot::speed:
+            return this->build_speed( buffer, frame.time_passed, frame.num_task_done, frame.num_all_tasks );
+          case Slot::elapsed: return this->build_elapsed( buffer, frame.time_passed );
+          case Slot::countdown:
+            return this->build_countdown( buffer,
+                                          frame.time_passed,
+                                          frame.num_task_done,
+                                          frame.num_all_tasks );
+          default: return buffer;
+          }
+        }
+
+        /**
+         * Get the size computed by `compute`, which only runs again if the config has been changed since;
+         * `compute` locks the config by itself.
+         *
+         * If the config is changed while `compute` runs, the result is kept with the older generation,
+         * so it is computed once more on the next call.
+         */
+        template<typename F>
+        __PGBAR_INLINE_FN types::Size cached_size( F&& compute ) const
+        {
+          __PGBAR_ASSERT( on_render_thread() );
+          return full_size_.get( this->rw_mtx_.generation( std::memory_order_relaxed ),
+                                 std::forward<F>( compute ) );
+        }
+        // The number of changes made to the config so far, a new one means the frame must be drawn again.
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size generation() const noexcept
+        {
+          return this->rw_mtx_.generation();
+        }
+
+        /**
+         * Compile the frame program and draw the pieces of the bar again,
+         * if the config has been changed since; the config must be locked for reading.
+         */
+        __PGBAR_INLINE_FN void prepare() const
+        {
+          // Two threads refreshing the caches at once would race, since both only hold the shared lock.
+          __PGBAR_ASSERT( on_render_thread() );
+          const auto& builder   = static_cast<const Builder<ConfigType>&>( *this );
+          const auto generation = this->rw_mtx_.generation();
+          __PGBAR_UNLIKELY if ( program_.stale( generation ) )
+          {
+            auto& statics = program_.recompile();
+            builder.layout( statics, [this]( io::Stringbuf&, Slot slot ) { program_.mark( slot ); } );
+            builder.cache_bar( cache_ );
+            program_.commit( generation );
+          }
+        }
+        // Get the pieces of the bar drawn by `prepare()`.
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN const asset::BarCache& bar_cache() const noexcept
+        {
+          return cache_;
+        }
+
+        // Build a frame from the compiled program; the config must be locked for reading.
+        __PGBAR_INLINE_FN io::Stringbuf& run_program( io::Stringbuf& buffer, const FrameData& frame ) const
+        {
+          const auto& builder = static_cast<const Builder<ConfigType>&>( *this );
+          prepare();
+          return program_.run( buffer, [&builder, &frame]( io::Stringbuf& buf, Slot slot ) {
+            builder.fill( buf, slot, frame );
+          } );
+        }
+      };
       template<>
       struct Builder<config::CharBar> final : public CommonBuilder<config::CharBar> {
         using self = config::CharBar;
         using CommonBuilder<self>::CommonBuilder;
         virtual ~Builder() noexcept = default;
 
-        __PGBAR_INLINE_FN io::Stringbuf& build(
-          io::Stringbuf& buffer,
-          types::Size num_frame_cnt,
-          types::Size num_task_done,
-          types::Size num_all_tasks,
-          const std::chrono::steady_clock::time_point& zero_point ) const
+        // Lay out a frame, `sink` is called for each part that changes from one frame to another.
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& layout( io::Stringbuf& buffer, Sink&& sink ) const
         {
-          __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          const auto num_percent = static_cast<types::Float>( num_task_done ) / num_all_tasks;
-
-          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
-          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
           if ( !this->description_.empty() || this->visual_masks_.any() )
             this->build_lborder( buffer );
 
@@ -3959,38 +5520,29 @@ namespace pgbar {
             this->build_divider( buffer );
           if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
             this->build_font( buffer, this->info_col_ );
-            buffer << this->build_percent( num_percent );
+            sink( buffer, Slot::percent );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Per ) ).any() )
               this->build_divider( buffer );
           }
           if ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ) {
-            this->build_char( buffer, num_frame_cnt, num_percent );
+            sink( buffer, Slot::animation );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Ani ) )
                    .reset( trait::as_val( self::Mask::Per ) )
                    .any() )
               this->build_divider( buffer );
           }
-          this->common_build( buffer, num_task_done, num_all_tasks, zero_point );
+          this->common_layout( buffer, sink );
 
           if ( !this->description_.empty() || this->visual_masks_.any() )
             this->build_rborder( buffer );
           return buffer << console::escape::reset_font;
         }
-        __PGBAR_INLINE_FN io::Stringbuf& build(
-          io::Stringbuf& buffer,
-          types::Size num_frame_cnt,
-          types::Size num_task_done,
-          types::Size num_all_tasks,
-          bool final_mesg,
-          const std::chrono::steady_clock::time_point& zero_point ) const
+        // Lay out the last frame, `sink` is called for each part that changes from one frame to another.
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& layout( io::Stringbuf& buffer, bool final_mesg, Sink&& sink ) const
         {
-          __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          const auto num_percent = static_cast<types::Float>( num_task_done ) / num_all_tasks;
-
-          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
-          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
           if ( ( !( final_mesg ? this->true_mesg_ : this->false_mesg_ ).empty()
                  || !this->description_.empty() )
                || this->visual_masks_.any() )
@@ -4004,20 +5556,20 @@ namespace pgbar {
           if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
             buffer << console::escape::reset_font;
             this->build_font( buffer, this->info_col_ );
-            buffer << this->build_percent( num_percent );
+            sink( buffer, Slot::percent );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Per ) ).any() )
               this->build_divider( buffer );
           }
           if ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ) {
-            this->build_char( buffer, num_frame_cnt, num_percent );
+            sink( buffer, Slot::animation );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Ani ) )
                    .reset( trait::as_val( self::Mask::Per ) )
                    .any() )
               this->build_divider( buffer );
           }
-          this->common_build( buffer, num_task_done, num_all_tasks, zero_point );
+          this->common_layout( buffer, sink );
 
           if ( ( !( final_mesg ? this->true_mesg_ : this->false_mesg_ ).empty()
                  || !this->description_.empty() )
@@ -4025,12 +5577,61 @@ namespace pgbar {
             this->build_rborder( buffer );
           return buffer << console::escape::reset_font;
         }
+        __PGBAR_INLINE_FN void cache_bar( asset::BarCache& cache ) const { this->cache_char( cache ); }
+        __PGBAR_INLINE_FN io::Stringbuf& fill( io::Stringbuf& buffer,
+                                               Slot slot,
+                                               const FrameData& frame ) const
+        {
+          if ( slot == Slot::animation )
+            return this->build_char( buffer, this->bar_cache(), frame.num_frame_cnt, frame.num_percent );
+          return this->fill_meter( buffer, slot, frame );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& build(
+          io::Stringbuf& buffer,
+          types::Size num_frame_cnt,
+          types::Size num_task_done,
+          types::Size num_all_tasks,
+          const std::chrono::steady_clock::time_point& zero_point ) const
+        {
+          const FrameData frame { num_frame_cnt, num_task_done, num_all_tasks, zero_point };
+          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+          return this->run_program( buffer, frame );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& build(
+          io::Stringbuf& buffer,
+          types::Size num_frame_cnt,
+          types::Size num_task_done,
+          types::Size num_all_tasks,
+          bool final_mesg,
+          const std::chrono::steady_clock::time_point& zero_point ) const
+        {
+          const FrameData frame { num_frame_cnt, num_task_done, num_all_tasks, zero_point };
+          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+          this->prepare();
+          return layout( buffer, final_mesg, [this, &frame]( io::Stringbuf& buf, Slot slot ) {
+            this->fill( buf, slot, frame );
+          } );
+        }
         __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size full_render_size() const
+        {
+          return this->cached_size( [this]() -> types::Size {
+            concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+            std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+            return ConfigInfo<self>::fixed_render_size( *this )
+                 + ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ? this->bar_length_ : 0 );
+          } );
+        }
+        // Identify the animation frame drawn for `num_frame_cnt`, so that unchanged frames can be skipped.
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size animation_frame( types::Size num_frame_cnt ) const
         {
           concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
           std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
-          return ConfigInfo<self>::fixed_render_size( *this )
-               + ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ? this->bar_length_ : 0 );
+          if ( !this->visual_masks_[trait::as_val( self::Mask::Ani )] || this->lead_.empty() )
+            return 0;
+          num_frame_cnt *= this->shift_factor_;
+          return num_frame_cnt % this->lead_.size();
         }
       };
 
@@ -4040,17 +5641,10 @@ namespace pgbar {
         using CommonBuilder<self>::CommonBuilder;
         virtual ~Builder() noexcept = default;
 
-        __PGBAR_INLINE_FN io::Stringbuf& build(
-          io::Stringbuf& buffer,
-          types::Size num_task_done,
-          types::Size num_all_tasks,
-          const std::chrono::steady_clock::time_point& zero_point ) const
+        // Lay out a frame, `sink` is called for each part that changes from one frame to another.
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& layout( io::Stringbuf& buffer, Sink&& sink ) const
         {
-          __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          const auto num_percent = static_cast<types::Float>( num_task_done ) / num_all_tasks;
-
-          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
-          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
           if ( !this->description_.empty() || this->visual_masks_.any() )
             this->build_lborder( buffer );
 
@@ -4060,37 +5654,29 @@ namespace pgbar {
           if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
             buffer << console::escape::reset_font;
             this->build_font( buffer, this->info_col_ );
-            buffer << this->build_percent( num_percent );
+            sink( buffer, Slot::percent );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Per ) ).any() )
               this->build_divider( buffer );
           }
           if ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ) {
-            this->build_block( buffer, num_percent );
+            sink( buffer, Slot::animation );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Ani ) )
                    .reset( trait::as_val( self::Mask::Per ) )
                    .any() )
               this->build_divider( buffer );
           }
-          this->common_build( buffer, num_task_done, num_all_tasks, zero_point );
+          this->common_layout( buffer, sink );
 
           if ( !this->description_.empty() || this->visual_masks_.any() )
             this->build_rborder( buffer );
           return buffer << console::escape::reset_font;
         }
-        __PGBAR_INLINE_FN io::Stringbuf& build(
-          io::Stringbuf& buffer,
-          types::Size num_task_done,
-          types::Size num_all_tasks,
-          bool final_mesg,
-          const std::chrono::steady_clock::time_point& zero_point ) const
+        // Lay out the last frame, `sink` is called for each part that changes from one frame to another.
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& layout( io::Stringbuf& buffer, bool final_mesg, Sink&& sink ) const
         {
-          __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          const auto num_percent = static_cast<types::Float>( num_task_done ) / num_all_tasks;
-
-          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
-          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
           if ( ( !( final_mesg ? this->true_mesg_ : this->false_mesg_ ).empty()
                  || !this->description_.empty() )
                || this->visual_masks_.any() )
@@ -4104,20 +5690,20 @@ namespace pgbar {
           if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
             buffer << console::escape::reset_font;
             this->build_font( buffer, this->info_col_ );
-            buffer << this->build_percent( num_percent );
+            sink( buffer, Slot::percent );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Per ) ).any() )
               this->build_divider( buffer );
           }
           if ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ) {
-            this->build_block( buffer, num_percent );
+            sink( buffer, Slot::animation );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Ani ) )
                    .reset( trait::as_val( self::Mask::Per ) )
                    .any() )
               this->build_divider( buffer );
           }
-          this->common_build( buffer, num_task_done, num_all_tasks, zero_point );
+          this->common_layout( buffer, sink );
 
           if ( ( !( final_mesg ? this->true_mesg_ : this->false_mesg_ ).empty()
                  || !this->description_.empty() )
@@ -4125,12 +5711,49 @@ namespace pgbar {
             this->build_rborder( buffer );
           return buffer << console::escape::reset_font;
         }
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size full_render_size() const
+        __PGBAR_INLINE_FN void cache_bar( asset::BarCache& cache ) const { this->cache_block( cache ); }
+        __PGBAR_INLINE_FN io::Stringbuf& fill( io::Stringbuf& buffer,
+                                               Slot slot,
+                                               const FrameData& frame ) const
+        {
+          if ( slot == Slot::animation )
+            return this->build_block( buffer, this->bar_cache(), frame.num_percent );
+          return this->fill_meter( buffer, slot, frame );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& build(
+          io::Stringbuf& buffer,
+          types::Size num_task_done,
+          types::Size num_all_tasks,
+          const std::chrono::steady_clock::time_point& zero_point ) const
+        {
+          const FrameData frame { 0, num_task_done, num_all_tasks, zero_point };
+          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+          return this->run_program( buffer, frame );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& build(
+          io::Stringbuf& buffer,
+          types::Size num_task_done,
+          types::Size num_all_tasks,
+          bool final_mesg,
+          const std::chrono::steady_clock::time_point& zero_point ) const
         {
+          const FrameData frame { 0, num_task_done, num_all_tasks, zero_point };
           concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
           std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
-          return ConfigInfo<self>::fixed_render_size( *this )
-               + ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ? this->bar_length_ : 0 );
+          this->prepare();
+          return layout( buffer, final_mesg, [this, &frame]( io::Stringbuf& buf, Slot slot ) {
+            this->fill( buf, slot, frame );
+          } );
+        }
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size full_render_size() const
+        {
+          return this->cached_size( [this]() -> types::Size {
+            concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+            std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+            return ConfigInfo<self>::fixed_render_size( *this )
+                 + ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ? this->bar_length_ : 0 );
+          } );
         }
       };
 
@@ -4140,23 +5763,15 @@ namespace pgbar {
         using CommonBuilder<self>::CommonBuilder;
         virtual ~Builder() noexcept = default;
 
-        __PGBAR_INLINE_FN io::Stringbuf& build(
-          io::Stringbuf& buffer,
-          types::Size num_frame_cnt,
-          types::Size num_task_done,
-          types::Size num_all_tasks,
-          const std::chrono::steady_clock::time_point& zero_point ) const
+        // Lay out a frame, `sink` is called for each part that changes from one frame to another.
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& layout( io::Stringbuf& buffer, Sink&& sink ) const
         {
-          __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          const auto num_percent = static_cast<types::Float>( num_task_done ) / num_all_tasks;
-
-          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
-          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
           if ( this->visual_masks_.any() )
             this->build_lborder( buffer );
 
           if ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ) {
-            this->build_spinner( buffer, num_frame_cnt );
+            sink( buffer, Slot::animation );
             if ( !this->description_.empty() ) {
               buffer << constants::blank;
               this->build_description( buffer );
@@ -4168,38 +5783,29 @@ namespace pgbar {
           if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
             buffer << console::escape::reset_font;
             this->build_font( buffer, this->info_col_ );
-            buffer << this->build_percent( num_percent );
+            sink( buffer, Slot::percent );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Ani ) )
                    .reset( trait::as_val( self::Mask::Per ) )
                    .any() )
               this->build_divider( buffer );
           }
-          this->common_build( buffer, num_task_done, num_all_tasks, zero_point );
+          this->common_layout( buffer, sink );
 
           if ( this->visual_masks_.any() )
             this->build_rborder( buffer );
           return buffer << console::escape::reset_font;
         }
-        __PGBAR_INLINE_FN io::Stringbuf& build(
-          io::Stringbuf& buffer,
-          types::Size num_frame_cnt,
-          types::Size num_task_done,
-          types::Size num_all_tasks,
-          bool final_mesg,
-          const std::chrono::steady_clock::time_point& zero_point ) const
+        // Lay out the last frame, `sink` is called for each part that changes from one frame to another.
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& layout( io::Stringbuf& buffer, bool final_mesg, Sink&& sink ) const
         {
-          __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          const auto num_percent = static_cast<types::Float>( num_task_done ) / num_all_tasks;
-
-          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
-          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
           if ( this->visual_masks_.any() )
             this->build_lborder( buffer );
 
           if ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ) {
             if ( ( final_mesg ? this->true_mesg_ : this->false_mesg_ ).empty() ) {
-              this->build_spinner( buffer, num_frame_cnt );
+              sink( buffer, Slot::animation );
               if ( !this->description_.empty() )
                 buffer << constants::blank;
             }
@@ -4211,86 +5817,118 @@ namespace pgbar {
           if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
             buffer << console::escape::reset_font;
             this->build_font( buffer, this->info_col_ );
-            buffer << this->build_percent( num_percent );
+            sink( buffer, Slot::percent );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Ani ) )
                    .reset( trait::as_val( self::Mask::Per ) )
                    .any() )
               this->build_divider( buffer );
           }
-          this->common_build( buffer, num_task_done, num_all_tasks, zero_point );
+          this->common_layout( buffer, sink );
 
           if ( this->visual_masks_.any() )
             this->build_rborder( buffer );
           return buffer << console::escape::reset_font;
         }
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size full_render_size() const
+        __PGBAR_INLINE_FN void cache_bar( asset::BarCache& cache ) const { this->cache_spinner( cache ); }
+        __PGBAR_INLINE_FN io::Stringbuf& fill( io::Stringbuf& buffer,
+                                               Slot slot,
+                                               const FrameData& frame ) const
+        {
+          if ( slot == Slot::animation )
+            return this->build_spinner( buffer, this->bar_cache(), frame.num_frame_cnt );
+          return this->fill_meter( buffer, slot, frame );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& build(
+          io::Stringbuf& buffer,
+          types::Size num_frame_cnt,
+          types::Size num_task_done,
+          types::Size num_all_tasks,
+          const std::chrono::steady_clock::time_point& zero_point ) const
         {
+          const FrameData frame { num_frame_cnt, num_task_done, num_all_tasks, zero_point };
           concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
           std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
-          return ConfigInfo<self>::fixed_render_size( *this );
+          return this->run_program( buffer, frame );
         }
-      };
-
-      template<>
-      struct Builder<config::ScanBar> final : public CommonBuilder<config::ScanBar> {
-        using self = config::ScanBar;
-        using CommonBuilder<self>::CommonBuilder;
-        virtual ~Builder() noexcept = default;
-
         __PGBAR_INLINE_FN io::Stringbuf& build(
           io::Stringbuf& buffer,
           types::Size num_frame_cnt,
           types::Size num_task_done,
           types::Size num_all_tasks,
+          bool final_mesg,
           const std::chrono::steady_clock::time_point& zero_point ) const
         {
-          __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          const auto num_percent = static_cast<types::Float>( num_task_done ) / num_all_tasks;
-
+          const FrameData frame { num_frame_cnt, num_task_done, num_all_tasks, zero_point };
           concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
           std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
-          if ( !this->description_.empty() || this->visual_masks_.any() )
-            this->build_lborder( buffer );
-
-          this->build_description( buffer );
-          if ( !this->description_.empty() && this->visual_masks_.any() )
-            this->build_divider( buffer );
-          if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
-            buffer << console::escape::reset_font;
-            this->build_font( buffer, this->info_col_ );
-            buffer << this->build_percent( num_percent );
-            auto masks = this->visual_masks_;
-            if ( masks.reset( trait::as_val( self::Mask::Per ) ).any() )
-              this->build_divider( buffer );
+          this->prepare();
+          return layout( buffer, final_mesg, [this, &frame]( io::Stringbuf& buf, Slot slot ) {
+            this->fill( buf, slot, frame );
+          } );
+        }
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size full_render_size() const
+        {
+          return this->cached_size( [this]() -> types::Size {
+            concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+            std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+            return ConfigInfo<self>::fixed_render_size( *this );
+          } );
+        }
+        // Identify the animation frame drawn for `num_frame_cnt`, so that unchanged frames can be skipped.
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size animation_frame( types::Size num_frame_cnt ) const
+        {
+          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+          if ( !this->visual_masks_[trait::as_val( self::Mask::Ani )] || this->lead_.empty() )
+            return 0;
+          num_frame_cnt *= this->shift_factor_;
+          return num_frame_cnt % this->lead_.size();
+        }
+      };
+
+      template<>
+      struct Builder<config::ScanBar> final : public CommonBuilder<config::ScanBar> {
+        using self = config::ScanBar;
+        using CommonBuilder<self>::CommonBuilder;
+        virtual ~Builder() noexcept = default;
+
+        // Lay out a frame, `sink` is called for each part that changes from one frame to another.
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& layout( io::Stringbuf& buffer, Sink&& sink ) const
+        {
+          if ( !this->description_.empty() || this->visual_masks_.any() )
+            this->build_lborder( buffer );
+
+          this->build_description( buffer );
+          if ( !this->description_.empty() && this->visual_masks_.any() )
+            this->build_divider( buffer );
+          if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
+            buffer << console::escape::reset_font;
+            this->build_font( buffer, this->info_col_ );
+            sink( buffer, Slot::percent );
+            auto masks = this->visual_masks_;
+            if ( masks.reset( trait::as_val( self::Mask::Per ) ).any() )
+              this->build_divider( buffer );
           }
           if ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ) {
-            this->build_scanner( buffer, num_frame_cnt );
+            sink( buffer, Slot::animation );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Ani ) )
                    .reset( trait::as_val( self::Mask::Per ) )
                    .any() )
               this->build_divider( buffer );
           }
-          this->common_build( buffer, num_task_done, num_all_tasks, zero_point );
+          this->common_layout( buffer, sink );
 
           if ( !this->description_.empty() || this->visual_masks_.any() )
             this->build_rborder( buffer );
           return buffer << console::escape::reset_font;
         }
-        __PGBAR_INLINE_FN io::Stringbuf& build(
-          io::Stringbuf& buffer,
-          types::Size num_frame_cnt,
-          types::Size num_task_done,
-          types::Size num_all_tasks,
-          bool final_mesg,
-          const std::chrono::steady_clock::time_point& zero_point ) const
+        // Lay out the last frame, `sink` is called for each part that changes from one frame to another.
+        template<typename Sink>
+        __PGBAR_INLINE_FN io::Stringbuf& layout( io::Stringbuf& buffer, bool final_mesg, Sink&& sink ) const
         {
-          __PGBAR_ASSERT( num_task_done <= num_all_tasks );
-          const auto num_percent = static_cast<types::Float>( num_task_done ) / num_all_tasks;
-
-          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
-          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
           if ( ( !( final_mesg ? this->true_mesg_ : this->false_mesg_ ).empty()
                  || !this->description_.empty() )
                || this->visual_masks_.any() )
@@ -4304,20 +5942,20 @@ namespace pgbar {
           if ( this->visual_masks_[trait::as_val( self::Mask::Per )] ) {
             buffer << console::escape::reset_font;
             this->build_font( buffer, this->info_col_ );
-            buffer << this->build_percent( num_percent );
+            sink( buffer, Slot::percent );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Per ) ).any() )
               this->build_divider( buffer );
           }
           if ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ) {
-            this->build_scanner( buffer, num_frame_cnt );
+            sink( buffer, Slot::animation );
             auto masks = this->visual_masks_;
             if ( masks.reset( trait::as_val( self::Mask::Ani ) )
                    .reset( trait::as_val( self::Mask::Per ) )
                    .any() )
               this->build_divider( buffer );
           }
-          this->common_build( buffer, num_task_done, num_all_tasks, zero_point );
+          this->common_layout( buffer, sink );
 
           if ( ( !( final_mesg ? this->true_mesg_ : this->false_mesg_ ).empty()
                  || !this->description_.empty() )
@@ -4325,23 +5963,329 @@ namespace pgbar {
             this->build_rborder( buffer );
           return buffer << console::escape::reset_font;
         }
+        __PGBAR_INLINE_FN void cache_bar( asset::BarCache& cache ) const { this->cache_scanner( cache ); }
+        __PGBAR_INLINE_FN io::Stringbuf& fill( io::Stringbuf& buffer,
+                                               Slot slot,
+                                               const FrameData& frame ) const
+        {
+          if ( slot == Slot::animation )
+            return this->build_scanner( buffer, this->bar_cache(), frame.num_frame_cnt );
+          return this->fill_meter( buffer, slot, frame );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& build(
+          io::Stringbuf& buffer,
+          types::Size num_frame_cnt,
+          types::Size num_task_done,
+          types::Size num_all_tasks,
+          const std::chrono::steady_clock::time_point& zero_point ) const
+        {
+          const FrameData frame { num_frame_cnt, num_task_done, num_all_tasks, zero_point };
+          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+          return this->run_program( buffer, frame );
+        }
+        __PGBAR_INLINE_FN io::Stringbuf& build(
+          io::Stringbuf& buffer,
+          types::Size num_frame_cnt,
+          types::Size num_task_done,
+          types::Size num_all_tasks,
+          bool final_mesg,
+          const std::chrono::steady_clock::time_point& zero_point ) const
+        {
+          const FrameData frame { num_frame_cnt, num_task_done, num_all_tasks, zero_point };
+          concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+          std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+          this->prepare();
+          return layout( buffer, final_mesg, [this, &frame]( io::Stringbuf& buf, Slot slot ) {
+            this->fill( buf, slot, frame );
+          } );
+        }
         __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size full_render_size() const
+        {
+          return this->cached_size( [this]() -> types::Size {
+            concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
+            std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
+            return ConfigInfo<self>::fixed_render_size( *this )
+                 + ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ? this->bar_length_ : 0 );
+          } );
+        }
+        // Identify the animation frame drawn for `num_frame_cnt`, so that unchanged frames can be skipped.
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::Size animation_frame( types::Size num_frame_cnt ) const
         {
           concurrent::SharedMutexRef shared_end { this->rw_mtx_ };
           std::lock_guard<concurrent::SharedMutexRef> lock { shared_end };
-          return ConfigInfo<self>::fixed_render_size( *this )
-               + ( this->visual_masks_[trait::as_val( self::Mask::Ani )] ? this->bar_length_ : 0 );
+          if ( !this->visual_masks_[trait::as_val( self::Mask::Ani )] || this->lead_.empty() )
+            return 0;
+          // The position of the lead depends on the whole frame count.
+          num_frame_cnt *= this->shift_factor_;
+          return num_frame_cnt;
         }
       };
 
       // A manager class used to synchronize the rendering thread and main thread.
+      class Renderer;
+
+      /**
+       * The render thread shared by every progress bar of the process.
+       *
+       * The renderers are kept in an intrusive list, so attaching and detaching one is O(1).
+       * The thread sleeps until the earliest frame is due, then draws every frame that is due,
+       * and the frames drawn in one step reach the terminal with one write per channel.
+       * A renderer changing its state wakes the thread up to be stepped at once.
+       *
+       * The renderers are stepped and the frames are written without the lock,
+       * so attaching or waking up a renderer never waits for the terminal.
+       */
+      class Scheduler final {
+        using self = Scheduler;
+
+        Renderer* head_;
+        // Set when a renderer needs to be stepped before the deadline.
+        bool pending_;
+        // Whether the thread is running; it exits when idle if it isn't kept alive.
+        bool alive_;
+        // Cleared when the settings change, the thread applies them to itself before the next step.
+        bool configured_;
+        config::RenderThread settings_;
+        /**
+         * What the thread inherited from the thread that created it, and which of them it has changed;
+         * a setting that goes back to its default restores the inherited value.
+         * Only touched by the thread.
+         */
+        struct Inherited {
+# if defined( __linux__ )
+          cpu_set_t cpus;
+          int policy;
+          sched_param param;
+          int niceness;
+# elif __PGBAR_WIN
+          DWORD_PTR cpus;
+          int priority;
+# endif
+          bool cpus_changed;
+          bool policy_changed;
+          bool niceness_changed;
+        };
+        Inherited inherited_;
+        // Set while the thread is stepping the renderers it has copied from the list.
+        bool stepping_;
+        // Only touched by the thread, it keeps its capacity between the steps.
+        std::vector<Renderer*> snapshot_;
+
+        std::mutex mtx_;
+        std::condition_variable cond_var_;
+        // Notified when the thread stops stepping.
+        std::condition_variable stepped_;
+# if __PGBAR_UNIX
+        // Created by pthread directly, since `std::thread` can't be given a stack size.
+        pthread_t td_;
+        bool joinable_;
+# else
+        std::thread td_;
+# endif
+
+        Scheduler()
+          : head_ { nullptr }
+          , pending_ { false }
+          , alive_ { false }
+          , configured_ { false }
+          , inherited_ {}
+          , stepping_ { false }
+# if __PGBAR_UNIX
+          , td_ {}
+          , joinable_ { false }
+# endif
+        {}
+
+        void run();
+
+        // Called by the thread on itself when it starts.
+        void inherit() & noexcept
+        {
+          inherited_.cpus_changed = inherited_.policy_changed = inherited_.niceness_changed = false;
+# if defined( __linux__ )
+          const auto handle = pthread_self();
+          CPU_ZERO( &inherited_.cpus );
+          pthread_getaffinity_np( handle, sizeof( inherited_.cpus ), &inherited_.cpus );
+          pthread_getschedparam( handle, &inherited_.policy, &inherited_.param );
+          inherited_.niceness = getpriority( PRIO_PROCESS, static_cast<id_t>( syscall( SYS_gettid ) ) );
+# elif __PGBAR_WIN
+          inherited_.cpus     = 0;
+          inherited_.priority = GetThreadPriority( GetCurrentThread() );
+# endif
+        }
+
+        /**
+         * Called by the thread on itself.
+         * Only the settings the user has set are applied, so that a policy or a nice value the thread
+         * inherited, e.g. from `chrt` or `nice`, is kept otherwise.
+         */
+        void apply( const config::RenderThread& settings ) & noexcept
+        {
+# if defined( __linux__ )
+          const auto handle = pthread_self();
+          if ( !settings.cpus.empty() ) {
+            cpu_set_t set;
+            CPU_ZERO( &set );
+            for ( const auto cpu : settings.cpus )
+              if ( cpu < CPU_SETSIZE )
+                CPU_SET( cpu, &set );
+            if ( pthread_setaffinity_np( handle, sizeof( set ), &set ) == 0 )
+              inherited_.cpus_changed = true;
+          } else if ( inherited_.cpus_changed ) {
+            pthread_setaffinity_np( handle, sizeof( inherited_.cpus ), &inherited_.cpus );
+            inherited_.cpus_changed = false;
+          }
+
+          if ( settings.idle ) {
+            sched_param param {};
+            if ( pthread_setschedparam( handle, SCHED_IDLE, &param ) == 0 )
+              inherited_.policy_changed = true;
+          } else if ( inherited_.policy_changed ) {
+            pthread_setschedparam( handle, inherited_.policy, &inherited_.param );
+            inherited_.policy_changed = false;
+          }
+
+          const auto tid = static_cast<id_t>( syscall( SYS_gettid ) );
+          if ( !settings.idle && settings.niceness != 0 ) {
+            if ( setpriority( PRIO_PROCESS, tid, settings.niceness ) == 0 )
+              inherited_.niceness_changed = true;
+          } else if ( inherited_.niceness_changed ) {
+            setpriority( PRIO_PROCESS, tid, inherited_.niceness );
+            inherited_.niceness_changed = false;
+          }
+          pthread_setname_np( handle, settings.name.substr( 0, 15 ).c_str() );
+# elif __PGBAR_WIN
+          const auto handle = GetCurrentThread();
+          DWORD_PTR mask    = 0;
+          for ( const auto cpu : settings.cpus )
+            if ( cpu < sizeof( DWORD_PTR ) * 8 )
+              mask |= static_cast<DWORD_PTR>( 1 ) << cpu;
+          if ( mask != 0 ) {
+            // The affinity of a thread can only be read by changing it.
+            const auto previous = SetThreadAffinityMask( handle, mask );
+            if ( previous != 0 && !inherited_.cpus_changed ) {
+              inherited_.cpus         = previous;
+              inherited_.cpus_changed = true;
+            }
+          } else if ( inherited_.cpus_changed ) {
+            SetThreadAffinityMask( handle, inherited_.cpus );
+            inherited_.cpus_changed = false;
+          }
+
+          if ( settings.idle ) {
+            if ( SetThreadPriority( handle, THREAD_PRIORITY_IDLE ) )
+              inherited_.policy_changed = true;
+          } else if ( inherited_.policy_changed ) {
+            SetThreadPriority( handle, inherited_.priority );
+            inherited_.policy_changed = false;
+          }
+# else
+          (void)settings;
+# endif
+        }
+
+        // Must be called with the lock held.
+        void revive() &
+        {
+          configured_ = false;
+# if __PGBAR_UNIX
+          // The last thread has left the loop already, so it's joined at once.
+          if ( joinable_ ) {
+            pthread_join( td_, nullptr );
+            joinable_ = false;
+          }
+          pthread_attr_t attr;
+          pthread_attr_init( &attr );
+          // A size the system refuses leaves the default one.
+          if ( settings_.stack_size != 0 )
+            pthread_attr_setstacksize( &attr, settings_.stack_size );
+          const auto error = pthread_create(
+            &td_,
+            &attr,
+            []( void* scheduler ) -> void* {
+              static_cast<self*>( scheduler )->run();
+              return nullptr;
+            },
+            this );
+          pthread_attr_destroy( &attr );
+          if ( error != 0 )
+            throw std::system_error( error,
+                                     std::generic_category(),
+                                     "pgbar: failed to create the render thread" );
+          joinable_ = true;
+# else
+          if ( td_.joinable() )
+            td_.join();
+          td_ = std::thread( [this]() { run(); } );
+# endif
+          alive_ = true;
+        }
+
+      public:
+        Scheduler( const self& )       = delete;
+        self& operator=( const self& ) = delete;
+
+        // Never destroyed, so that the bars destructed during static destruction can still detach.
+        static self& instance()
+        {
+          static self* const scheduler = new self();
+          return *scheduler;
+        }
+
+        void attach( Renderer& renderer ) &;
+        // Blocks while the thread is stepping, so the renderer is never touched once it returns.
+        void detach( Renderer& renderer ) & noexcept;
+
+        // Step the renderers at once, the thread is started if it isn't running.
+        void notify() &
+        {
+          {
+            std::lock_guard<std::mutex> lock { mtx_ };
+            pending_ = true;
+            __PGBAR_UNLIKELY if ( !alive_ ) revive();
+          }
+          cond_var_.notify_one();
+        }
+        // Wake up the thread if it's running, so that it can exit if it's idle and no longer kept alive.
+        void nudge() & noexcept
+        {
+          {
+            std::lock_guard<std::mutex> lock { mtx_ };
+            if ( !alive_ )
+              return;
+            pending_ = true;
+          }
+          cond_var_.notify_one();
+        }
+
+        void configure( config::RenderThread settings ) &
+        {
+          {
+            std::lock_guard<std::mutex> lock { mtx_ };
+            settings_   = std::move( settings );
+            configured_ = false;
+            if ( !alive_ )
+              return;
+            pending_ = true;
+          }
+          cond_var_.notify_one();
+        }
+        __PGBAR_NODISCARD config::RenderThread settings() &
+        {
+          std::lock_guard<std::mutex> lock { mtx_ };
+          return settings_;
+        }
+      };
+
       class Renderer final {
         using self = Renderer;
+        friend class Scheduler;
         /* The state transfer process is:
          *                   activate()                   suspend()
          * dormant(default) -----------> awake -> active ----------> suspend -> dormat
-         *              dctor
-         * (any state) ------> finish
+         *              reset()
+         * (any state) ---------> finish
          *              catch an exception while box_ isn't empty
          * (any state) ------------------------------------------> dead*/
         enum class state : types::BitwiseSet { dormant, awake, active, suspend, finish, dead };
@@ -4350,85 +6294,139 @@ namespace pgbar {
 
         std::atomic<state> state_;
         concurrent::ExceptionBox box_;
+# ifndef __cpp_lib_atomic_wait
+        // Only used to block the threads waiting for a state transfer.
+        std::mutex mtx_;
+        std::condition_variable cond_var_;
+# endif
 
-        mutable std::condition_variable cond_var_;
-        mutable std::mutex mtx_;
+        // Where the refresh interval comes from, the global one is used if it's null.
+        const config::Core* config_;
 
-        std::thread td_;
+        // Guarded by the lock of the scheduler.
+        Renderer* prev_;
+        Renderer* next_;
+        bool attached_;
+        std::chrono::steady_clock::time_point last_frame_;
+
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN types::TimeUnit interval() const noexcept
+        {
+          return config_ != nullptr ? config_->interval() : config::Core::refresh_interval();
+        }
 
-        // initialize the thread object
         __PGBAR_INLINE_FN void reboot() &
         {
           __PGBAR_ASSERT( task_ != nullptr );
           state_.store( state::dormant, std::memory_order_release );
-          // A thread object is a mutually exclusive resource.
-          td_ = std::thread( [this]() -> void {
-            while ( state_.load( std::memory_order_acquire ) != state::finish ) {
-              try {
-                switch ( state_.load( std::memory_order_acquire ) ) {
-                case state::dormant: {
-                  std::unique_lock<std::mutex> lock { mtx_ };
-                  cond_var_.wait( lock, [this]() noexcept -> bool {
-                    return state_.load( std::memory_order_acquire ) != state::dormant;
-                  } );
-                } break;
-
-                case state::awake: { // Intermediate state
-                  // Used to tell other threads that the current thread has woken up.
-                  task_->run();
-                  auto expected = state::awake;
-                  state_.compare_exchange_strong( expected,
-                                                  state::active,
-                                                  std::memory_order_acq_rel,
-                                                  std::memory_order_relaxed );
-                } break;
-                  /* The state `awake` does not jump to `active` by using `fallthrough`,
-                   * because we need to ensure that `suspend` must be transferred from `active`.
-
-                   * In some cases the `state` transition
-                   * won't work as well as we'd like if we use `fallthrough` here. */
-
-                case state::active: {
-                  task_->run();
-                  std::this_thread::sleep_for( config::Core::refresh_interval() );
-                } break;
-
-                case state::suspend: {
-                  task_->run();
-                  /* We expect the progress bar to be waiting for output to show that
-                   * the iteration is complete at this point,
-                   * so we should render it one last time before moving to `dormat` here. */
-
-                  auto expected = state::suspend;
-                  state_.compare_exchange_strong( expected,
-                                                  state::dormant,
-                                                  std::memory_order_acq_rel,
-                                                  std::memory_order_relaxed );
-                } break;
+          Scheduler::instance().attach( *this );
+        }
 
-                default: return;
-                }
-              } catch ( ... ) {
-                // keep object valid
-                if ( box_.empty() ) {
-                  auto try_update = [this]( state expected ) noexcept {
-                    return state_.compare_exchange_strong( expected,
-                                                           state::dormant,
-                                                           std::memory_order_acq_rel,
-                                                           std::memory_order_relaxed );
-                  };
-                  try_update( state::active ) || try_update( state::awake ) || try_update( state::suspend );
-                  // Avoid deadlock in main thread when the child thread catchs exception.
-                  auto exception = std::current_exception();
-                  if ( exception )
-                    box_.store( exception );
-                } else {
-                  state_.store( state::dead, std::memory_order_relaxed );
-                  throw; // Rethrow it, and let the current thread crash.
-                }
+        // Wake up the threads blocked in `activate()` or `suspend()`.
+        __PGBAR_INLINE_FN void notify_waiters() & noexcept
+        {
+# ifdef __cpp_lib_atomic_wait
+          state_.notify_all();
+# else
+          {
+            std::lock_guard<std::mutex> lock { mtx_ };
+          }
+          cond_var_.notify_all();
+# endif
+        }
+
+        // Block while the state is `from`, rethrow the exception the scheduler thread received meanwhile.
+        void wait_while( state from ) & noexcept( false )
+        {
+# ifdef __cpp_lib_atomic_wait
+          for ( auto current = state_.load( std::memory_order_acquire ); current == from;
+                current      = state_.load( std::memory_order_acquire ) ) {
+            __PGBAR_UNLIKELY if ( box_.empty() == false ) box_.rethrow();
+            state_.wait( current, std::memory_order_acquire );
+          }
+# else
+          std::unique_lock<std::mutex> lock { mtx_ };
+          cond_var_.wait( lock, [this, from]() noexcept {
+            return state_.load( std::memory_order_acquire ) != from || !box_.empty();
+          } );
+          lock.unlock();
+          __PGBAR_UNLIKELY if ( state_.load( std::memory_order_acquire ) == from ) box_.rethrow();
+# endif
+        }
+
+        /**
+         * Run one step of the state machine; called by the scheduler thread without its lock,
+         * while `detach()` waits for it to finish.
+         * Moves `wakeup` forward to the next frame of the renderer if it's running.
+         *
+         * A frame is drawn a little early if it's due within a quarter of the interval,
+         * so that bars with the same interval drift into the same step.
+         */
+        void step( const std::chrono::steady_clock::time_point& now,
+                   std::chrono::steady_clock::time_point& wakeup ) noexcept
+        {
+          const auto previous_state = state_.load( std::memory_order_acquire );
+          try {
+            switch ( state_.load( std::memory_order_acquire ) ) {
+            case state::awake: { // Intermediate state
+              // Used to tell other threads that the renderer has woken up.
+              task_->run();
+              last_frame_   = now;
+              auto expected = state::awake;
+              state_.compare_exchange_strong( expected,
+                                              state::active,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed );
+            } break;
+
+            case state::active: {
+              const auto rate = interval();
+              if ( now + rate / 4 >= last_frame_ + rate ) {
+                task_->run();
+                last_frame_ = now;
               }
+            } break;
+
+            case state::suspend: {
+              task_->run();
+              /* We expect the progress bar to be waiting for output to show that
+               * the iteration is complete at this point,
+               * so we should render it one last time before moving to `dormat` here. */
+
+              auto expected = state::suspend;
+              state_.compare_exchange_strong( expected,
+                                              state::dormant,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed );
+            } break;
+
+            default: break;
             }
-          } );
+          } catch ( ... ) {
+            // keep object valid
+            if ( box_.empty() ) {
+              auto try_update = [this]( state expected ) noexcept {
+                return state_.compare_exchange_strong( expected,
+                                                       state::dormant,
+                                                       std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed );
+              };
+              try_update( state::active ) || try_update( state::awake ) || try_update( state::suspend );
+              // Avoid deadlock in main thread when the render thread catchs exception.
+              auto exception = std::current_exception();
+              if ( exception )
+                box_.store( exception );
+            } else
+              // The thread is shared by other bars, so the exception is dropped instead of crashing it.
+              state_.store( state::dead, std::memory_order_release );
+          }
+
+          const auto current_state = state_.load( std::memory_order_acquire );
+          if ( current_state != previous_state )
+            notify_waiters();
+          if ( current_state == state::active )
+            wakeup = ( std::min )( wakeup, last_frame_ + interval() );
+          else if ( current_state == state::awake || current_state == state::suspend )
+            wakeup = now; // Still in a transition, so step it again at once.
         }
 
       public:
@@ -4436,7 +6434,14 @@ namespace pgbar {
         self& operator=( const self& ) = delete;
 
         // Lazily initialize.
-        Renderer() noexcept : task_ { nullptr }, state_ { state::dormant } {}
+        Renderer() noexcept
+          : task_ { nullptr }
+          , state_ { state::dormant }
+          , config_ { nullptr }
+          , prev_ { nullptr }
+          , next_ { nullptr }
+          , attached_ { false }
+        {}
 
         template<typename F>
         explicit Renderer( F&& task ) : Renderer()
@@ -4453,9 +6458,10 @@ namespace pgbar {
         __PGBAR_INLINE_FN
           typename std::enable_if<trait::is_void_functor<typename std::decay<F>::type>::value>::type
 # endif
-          reset( F&& task ) & noexcept( false )
+          reset( F&& task, const config::Core* config = nullptr ) & noexcept( false )
         {
           reset();
+          config_ = config;
 # if __PGBAR_CXX14
           task_ = std::make_unique<wrappers::RenderFnWrapper<typename std::decay<F>::type>>(
             std::forward<F>( task ) );
@@ -4473,15 +6479,9 @@ namespace pgbar {
         {
           // terminate rendered
           state_.store( state::finish, std::memory_order_release );
-          {
-            std::lock_guard<std::mutex> lock { mtx_ };
-            cond_var_.notify_all();
-          }
-          if ( td_.joinable() )
-            td_.join();
-
+          if ( task_ != nullptr )
+            Scheduler::instance().detach( *this );
           task_.reset();
-          td_ = std::thread();
         }
 
         // Check whether the lazy initialization object state is valid.
@@ -4500,38 +6500,441 @@ namespace pgbar {
           __PGBAR_UNLIKELY if ( state_.load( std::memory_order_acquire ) == state::dead ) reboot();
           else __PGBAR_UNLIKELY if ( box_.empty() == false ) box_.rethrow();
 
-          auto expected = state::dormant;
-          if ( state_.compare_exchange_strong( expected,
-                                               state::awake,
-                                               std::memory_order_acq_rel,
-                                               std::memory_order_relaxed ) ) {
-            {
-              std::lock_guard<std::mutex> lock { mtx_ };
-              cond_var_.notify_one();
+          // The renderer may have paused itself and is drawing its last frame, let it fall back to `dormant`.
+          wait_while( state::suspend );
+
+          auto expected = state::dormant;
+          if ( state_.compare_exchange_strong( expected,
+                                               state::awake,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_relaxed ) ) {
+            Scheduler::instance().notify();
+            // ensure that the scheduler has moved the renderer to the new state
+            wait_while( state::awake );
+          }
+        }
+
+        void suspend() & noexcept( false )
+        {
+          __PGBAR_ASSERT( valid() == true );
+          auto expected = state::active;
+          if ( state_.compare_exchange_strong( expected,
+                                               state::suspend,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_relaxed ) ) {
+            Scheduler::instance().notify();
+            wait_while( state::suspend );
+          } else
+            __PGBAR_UNLIKELY if ( box_.empty() == false ) box_.rethrow();
+        }
+
+        /**
+         * Called by the render thread itself to move to `suspend` without waiting,
+         * so that the task it is running becomes the last one before `dormant`.
+         */
+        void pause() & noexcept
+        {
+          auto try_update = [this]( state expected ) noexcept {
+            return state_.compare_exchange_strong( expected,
+                                                   state::suspend,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed );
+          };
+          try_update( state::active ) || try_update( state::awake );
+        }
+      };
+
+      inline void Scheduler::attach( Renderer& renderer ) &
+      {
+        std::lock_guard<std::mutex> lock { mtx_ };
+        if ( renderer.attached_ )
+          return;
+
+        renderer.prev_ = nullptr;
+        renderer.next_ = head_;
+        if ( head_ != nullptr )
+          head_->prev_ = std::addressof( renderer );
+        head_              = std::addressof( renderer );
+        renderer.attached_ = true;
+      }
+
+      inline void Scheduler::detach( Renderer& renderer ) & noexcept
+      {
+        std::unique_lock<std::mutex> lock { mtx_ };
+        if ( !renderer.attached_ )
+          return;
+        if ( renderer.prev_ != nullptr )
+          renderer.prev_->next_ = renderer.next_;
+        else
+          head_ = renderer.next_;
+        if ( renderer.next_ != nullptr )
+          renderer.next_->prev_ = renderer.prev_;
+        renderer.prev_ = renderer.next_ = nullptr;
+        renderer.attached_              = false;
+        // The thread may still be stepping it from its copy of the list.
+        stepped_.wait( lock, [this]() noexcept { return !stepping_; } );
+      }
+
+      inline void Scheduler::run()
+      {
+        auto& batch = io::FrameBatch::local();
+        on_render_thread() = true;
+        std::unique_lock<std::mutex> lock { mtx_ };
+        inherit();
+        auto wakeup = std::chrono::steady_clock::time_point::max();
+        while ( true ) {
+          // Sleep without a deadline if no renderer is running.
+          // The clock of the bars may not be `steady_clock`, so the deadline is turned into a duration.
+          if ( wakeup != std::chrono::steady_clock::time_point::max() )
+            cond_var_.wait_for( lock, wakeup - config::Core::now(), [this]() noexcept { return pending_; } );
+          else
+            cond_var_.wait( lock, [this]() noexcept { return pending_; } );
+          pending_ = false;
+          __PGBAR_UNLIKELY if ( !configured_ )
+          {
+            apply( settings_ );
+            configured_ = true;
+          }
+
+          snapshot_.clear();
+          for ( auto renderer = head_; renderer != nullptr; renderer = renderer->next_ )
+            snapshot_.push_back( renderer );
+          stepping_ = true;
+          lock.unlock();
+
+          const auto now = config::Core::now();
+          wakeup         = std::chrono::steady_clock::time_point::max();
+          batch.open();
+          for ( const auto renderer : snapshot_ )
+            renderer->step( now, wakeup );
+
+          // The frames are copied into the batch, so the renderers can be detached before the write.
+          lock.lock();
+          stepping_ = false;
+          lock.unlock();
+          stepped_.notify_all();
+          try {
+            batch.close();
+          } catch ( ... ) {
+            // Nothing can be done if the terminal can't be reached, the frames are dropped.
+          }
+          lock.lock();
+
+          /* The renderers stay attached, the next one activated starts a new thread.
+           * A renderer woken up while the lock was released is still pending, so the thread stays. */
+          if ( wakeup == std::chrono::steady_clock::time_point::max() && !pending_
+               && !config::Core::keep_alive() ) {
+            alive_ = false;
+            return;
+          }
+        }
+      }
+    } // namespace render
+  } // namespace __detail
+
+  namespace config {
+    inline void Core::keep_alive( bool keep ) noexcept
+    {
+      _keep_alive.store( keep, std::memory_order_release );
+      if ( !keep )
+        __detail::render::Scheduler::instance().nudge();
+    }
+    inline void Core::render_thread( RenderThread settings )
+    {
+      __detail::render::Scheduler::instance().configure( std::move( settings ) );
+    }
+    inline RenderThread Core::render_thread()
+    {
+      return __detail::render::Scheduler::instance().settings();
+    }
+  } // namespace config
+
+  namespace __detail {
+    namespace render {
+
+      /**
+       * Remembers what the last frame showed, so that a refresh drawing the same frame can be skipped.
+       *
+       * While the frames stay the same, the bar is checked less and less often,
+       * up to once every `max_backoff` refreshes; any change brings it back to every refresh.
+       * A change of the config, known by its generation, counts as a change of the frame.
+       */
+      class FrameTracker final {
+        types::Size progress_;
+        types::Size seconds_;
+        types::Size animation_;
+        types::Size generation_;
+        types::Size backoff_;
+        types::Size countdown_;
+
+      public:
+        static constexpr types::Size max_backoff = 8;
+
+        __PGBAR_CXX14_CNSTXPR FrameTracker() noexcept
+          : progress_ { 0 }
+          , seconds_ { 0 }
+          , animation_ { 0 }
+          , generation_ { 0 }
+          , backoff_ { 1 }
+          , countdown_ { 0 }
+        {}
+
+        // Start over from a frame that has just been drawn.
+        __PGBAR_CXX14_CNSTXPR void reset( types::Size progress,
+                                          types::Size seconds,
+                                          types::Size animation,
+                                          types::Size generation ) & noexcept
+        {
+          progress_   = progress;
+          seconds_    = seconds;
+          animation_  = animation;
+          generation_ = generation;
+          backoff_    = 1;
+          countdown_  = 0;
+        }
+
+        // Whether the refresh can be skipped without looking at anything but the progress and the config.
+        __PGBAR_CXX14_CNSTXPR bool idle( types::Size progress, types::Size generation ) & noexcept
+        {
+          if ( progress != progress_ || generation != generation_ ) {
+            backoff_   = 1;
+            countdown_ = 0;
+            return false;
+          }
+          if ( countdown_ == 0 )
+            return false;
+          --countdown_;
+          return true;
+        }
+
+        // Record the frame of this refresh, and return whether it differs from the last one.
+        __PGBAR_CXX14_CNSTXPR bool update( types::Size progress,
+                                           types::Size seconds,
+                                           types::Size animation,
+                                           types::Size generation ) & noexcept
+        {
+          const bool dirty = progress != progress_ || seconds != seconds_ || animation != animation_
+                          || generation != generation_;
+          if ( dirty )
+            backoff_ = 1;
+          else
+            backoff_ = backoff_ * 2 < max_backoff ? backoff_ * 2 : max_backoff;
+          countdown_  = backoff_ - 1;
+          progress_   = progress;
+          seconds_    = seconds;
+          animation_  = animation;
+          generation_ = generation;
+          return dirty;
+        }
+
+        static types::Size seconds_since( const std::chrono::steady_clock::time_point& zero_point ) noexcept
+        {
+          return static_cast<types::Size>(
+            std::chrono::duration_cast<std::chrono::seconds>( config::Core::now() - zero_point )
+              .count() );
+        }
+      };
+
+      /**
+       * Keeps the last frame written to the terminal as a row of cells,
+       * so that the next frame only rewrites the cells that have changed
+       * and moves the cursor over the rest.
+       *
+       * A frame is drawn in full if its width differs from the last one,
+       * if it may not fit in one line of the terminal, or if the terminal has been resized since,
+       * which may have reflowed the last frame.
+       */
+      class FrameDiff final {
+        struct Cell {
+          // The bytes of the glyph in `Frame::bytes`.
+          types::Size glyph_begin, glyph_end;
+          // The bytes of the escape codes in effect for the glyph in `Frame::styles`.
+          types::Size style_begin, style_end;
+          types::Size width;
+        };
+        struct Frame {
+          io::Stringbuf bytes;
+          // Every escape code of the frame, the ones after the last reset are in effect.
+          io::Stringbuf styles;
+          std::vector<Cell> cells;
+          types::Size width = 0;
+
+          void swap( Frame& lhs ) noexcept
+          {
+            bytes.swap( lhs.bytes );
+            styles.swap( lhs.styles );
+            cells.swap( lhs.cells );
+            std::swap( width, lhs.width );
+          }
+
+          // Split `bytes` into cells.
+          void parse() &
+          {
+            cells.clear();
+            styles.clear();
+            width = 0;
+
+            const auto data = bytes.data();
+            const auto size = bytes.size();
+            // The style in effect is always at the end of `styles`.
+            types::Size style_begin = 0;
+            for ( types::Size i = 0; i < size; ) {
+              if ( data[i] == '\x1B' ) {
+                auto j = i + 1;
+                if ( j < size && data[j] == '[' )
+                  while ( ++j < size && ( data[j] < 0x40 || data[j] > 0x7E ) ) {}
+                j = j < size ? j + 1 : size;
+                // Both `\x1B[0m` and `\x1B[m` reset the font.
+                if ( data[j - 1] == 'm' && ( j - i == 3 || ( j - i == 4 && data[i + 2] == '0' ) ) )
+                  style_begin = styles.size();
+                else
+                  styles.append( data + i, data + j );
+                i = j;
+                continue;
+              }
+
+              const auto lead   = static_cast<types::UCodePoint>( static_cast<unsigned char>( data[i] ) );
+              types::Size len         = 1;
+              types::Size glyph_width = 0;
+              if ( lead < 0x80 )
+                glyph_width = lead >= 0x20 && lead != 0x7F ? 1 : 0;
+              else {
+                types::UCodePoint codepoint = 0;
+                if ( ( lead & 0xE0 ) == 0xC0 ) {
+                  len       = 2;
+                  codepoint = lead & 0x1F;
+                } else if ( ( lead & 0xF0 ) == 0xE0 ) {
+                  len       = 3;
+                  codepoint = lead & 0xF;
+                } else if ( ( lead & 0xF8 ) == 0xF0 ) {
+                  len       = 4;
+                  codepoint = lead & 0x7;
+                }
+                len = ( std::min )( len, size - i );
+                for ( types::Size k = 1; k < len; ++k )
+                  codepoint = ( codepoint << 6 ) | ( static_cast<unsigned char>( data[i + k] ) & 0x3F );
+                glyph_width = charset::U8String::char_width( codepoint );
+              }
+
+              // Zero-width glyphs are drawn with the one before them.
+              if ( glyph_width == 0 && !cells.empty() && cells.back().glyph_end == i )
+                cells.back().glyph_end += len;
+              else
+                cells.push_back( { i, i + len, style_begin, styles.size(), glyph_width } );
+              width += glyph_width;
+              i += len;
+            }
+          }
+        };
+
+        // How many unchanged cells are rewritten rather than skipped, when they are between two changed ones.
+        static constexpr types::Size max_gap = 6;
+
+        Frame last_, next_;
+        types::Size columns_;
+        bool drawn_;
+
+        __PGBAR_NODISCARD bool changed( types::Size index ) const noexcept
+        {
+          const auto& before = last_.cells[index];
+          const auto& after  = next_.cells[index];
+          return before.width != after.width
+              || before.glyph_end - before.glyph_begin != after.glyph_end - after.glyph_begin
+              || before.style_end - before.style_begin != after.style_end - after.style_begin
+              || !std::equal( next_.bytes.data() + after.glyph_begin,
+                              next_.bytes.data() + after.glyph_end,
+                              last_.bytes.data() + before.glyph_begin )
+              || !std::equal( next_.styles.data() + after.style_begin,
+                              next_.styles.data() + after.style_end,
+                              last_.styles.data() + before.style_begin );
+        }
+
+        // Write the cells in `[first, last)` of the next frame, the cursor must be at the first one.
+        void paint( io::Stringbuf& buffer, types::Size first, types::Size last ) const
+        {
+          for ( auto i = first; i < last; ++i ) {
+            const auto& cell = next_.cells[i];
+            if ( i == first || cell.style_begin != next_.cells[i - 1].style_begin
+                 || cell.style_end != next_.cells[i - 1].style_end )
+              ( buffer << console::escape::reset_font )
+                .append( next_.styles.data() + cell.style_begin, next_.styles.data() + cell.style_end );
+            buffer.append( next_.bytes.data() + cell.glyph_begin, next_.bytes.data() + cell.glyph_end );
+          }
+          buffer << console::escape::reset_font;
+        }
+
+      public:
+        FrameDiff() noexcept : columns_ { 0 }, drawn_ { false } {}
+
+        // Get the empty buffer that the next frame is built in.
+        __PGBAR_INLINE_FN io::Stringbuf& canvas() & noexcept
+        {
+          next_.bytes.clear();
+          return next_.bytes;
+        }
+
+        // Write the frame in `canvas()` in full at the cursor, which is where the later frames are drawn.
+        template<StreamChannel StreamType>
+        void draw( io::OStream<StreamType>& stream ) &
+        {
+          columns_ = console::terminal_width<StreamType>();
+          next_.parse();
+          stream.append( next_.bytes.data(), next_.bytes.data() + next_.bytes.size() );
+          last_.swap( next_ );
+          drawn_ = true;
+        }
+
+        /**
+         * Write the frame in `canvas()` over the last one, starting from the stored cursor.
+         *
+         * If it's drawn in full, `clear_width` columns are cleared first.
+         */
+        template<StreamChannel StreamType>
+        void redraw( io::OStream<StreamType>& stream, types::Size clear_width ) &
+        {
+          // The terminal can be resized at any time, so its width is queried for every frame.
+          const auto columns = console::terminal_width<StreamType>();
+          const bool resized = columns != columns_;
+          columns_           = columns;
+          next_.parse();
+          stream << console::escape::restore_cursor;
+          if ( !drawn_ || resized || next_.width != last_.width || next_.cells.size() != last_.cells.size()
+               || next_.width >= columns_ ) {
+            stream << console::escape::clear_next( clear_width );
+            stream.append( next_.bytes.data(), next_.bytes.data() + next_.bytes.size() );
+          } else {
+            const auto num_cells = next_.cells.size();
+            // The column of the cursor, and of the cell `i`.
+            types::Size cursor = 0, column = 0;
+            for ( types::Size i = 0; i < num_cells; ) {
+              if ( !changed( i ) ) {
+                column += next_.cells[i++].width;
+                continue;
+              }
+
+              // Once the widths of the cells differ, the cells after them can't be compared.
+              bool shifted     = false;
+              auto run_end     = i;
+              auto end_column  = column;
+              auto scan_column = column;
+              for ( auto j = i; j < num_cells && j - run_end <= max_gap; ++j ) {
+                shifted = shifted || next_.cells[j].width != last_.cells[j].width;
+                scan_column += next_.cells[j].width;
+                if ( shifted || changed( j ) ) {
+                  run_end    = j + 1;
+                  end_column = scan_column;
+                }
+              }
+
+              if ( column > cursor ) // move the cursor forward
+                ( stream << "\x1B[" ).append_number( column - cursor ) << 'C';
+              paint( stream, i, run_end );
+              i      = run_end;
+              cursor = column = end_column;
             }
-            // spin wait, ensure that the thread has moved to the new state
-            do {
-              // avoid deadlock and throw the exception the thread received
-              __PGBAR_UNLIKELY if ( box_.empty() == false ) box_.rethrow();
-            } while ( state_.load( std::memory_order_acquire ) == state::awake
-                      && state_.load( std::memory_order_acquire ) != state::finish );
           }
-        }
-
-        void suspend() & noexcept( false )
-        {
-          __PGBAR_ASSERT( valid() == true );
-          auto expected = state::active;
-          if ( state_.compare_exchange_strong( expected,
-                                               state::suspend,
-                                               std::memory_order_acq_rel,
-                                               std::memory_order_relaxed ) ) {
-            do {
-              __PGBAR_UNLIKELY if ( box_.empty() == false ) box_.rethrow();
-            } while ( state_.load( std::memory_order_acquire ) == state::suspend
-                      && state_.load( std::memory_order_acquire ) != state::finish );
-          } else
-            __PGBAR_UNLIKELY if ( box_.empty() == false ) box_.rethrow();
+          last_.swap( next_ );
+          drawn_ = true;
         }
       };
 
@@ -4552,6 +6955,38 @@ namespace pgbar {
     __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR void lock() noexcept {}
     __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR void unlock() noexcept {}
   };
+  /**
+   * A lock type that makes the progress bar count ticks in per-thread slots.
+   *
+   * While the bar is running, a tick only touches the slot of the calling thread,
+   * and the rendering thread sums all slots when it builds a frame;
+   * the lock is taken only when the bar starts, stops or is reset.
+   */
+  class Threadsharded final {
+    __detail::concurrent::Mutex mtx_;
+
+  public:
+    Threadsharded() noexcept  = default;
+    ~Threadsharded() noexcept = default;
+    __PGBAR_INLINE_FN void lock() & noexcept { mtx_.lock(); }
+    __PGBAR_INLINE_FN void unlock() & noexcept { mtx_.unlock(); }
+  };
+  /**
+   * A lock type that makes the progress bar count ticks with a single atomic operation.
+   *
+   * The task counter and a flag of whether the bar is running are packed into one atomic word,
+   * so a tick is a saturating compare-and-swap on it; the lock is taken only when the bar starts,
+   * stops or is reset.
+   */
+  class Threadatomic final {
+    __detail::concurrent::Mutex mtx_;
+
+  public:
+    Threadatomic() noexcept  = default;
+    ~Threadatomic() noexcept = default;
+    __PGBAR_INLINE_FN void lock() & noexcept { mtx_.lock(); }
+    __PGBAR_INLINE_FN void unlock() & noexcept { mtx_.unlock(); }
+  };
 
   class Indicator {
   protected:
@@ -4563,6 +6998,26 @@ namespace pgbar {
     std::chrono::steady_clock::time_point zero_point_;
     __detail::types::Size max_bar_size_;
     bool final_mesg_;
+    // Only touched by the render thread.
+    __detail::render::FrameTracker tracker_;
+    __detail::render::FrameDiff painter_;
+
+    // Used by the timed waits, and by `wait()` if atomic waiting isn't available.
+    mutable std::mutex wait_mtx_;
+    mutable std::condition_variable wait_cond_;
+
+    // Move to `stopped` and wake up the waiting threads.
+    void stop() noexcept
+    {
+      {
+        std::lock_guard<std::mutex> lock { wait_mtx_ };
+        state_.store( state::stopped, std::memory_order_release );
+      }
+      wait_cond_.notify_all();
+# ifdef __cpp_lib_atomic_wait
+      state_.notify_all();
+# endif
+    }
 
     void unlock_reset( bool final_mesg )
     {
@@ -4577,7 +7032,7 @@ namespace pgbar {
         try_update( state::begin ) || try_update( state::refresh1 ) || try_update( state::refresh2 );
         this->executor_.suspend();
       } else
-        state_.store( state::stopped, std::memory_order_release );
+        stop();
     }
 
   public:
@@ -4606,20 +7061,28 @@ namespace pgbar {
     // Wait until the indicator is stopped.
     void wait() const
     {
-      while ( is_running() )
-        std::this_thread::yield();
+# ifdef __cpp_lib_atomic_wait
+      for ( auto current = state_.load( std::memory_order_acquire ); current != state::stopped;
+            current      = state_.load( std::memory_order_acquire ) )
+        state_.wait( current, std::memory_order_acquire );
+# else
+      std::unique_lock<std::mutex> lock { wait_mtx_ };
+      wait_cond_.wait( lock, [this]() noexcept { return !is_running(); } );
+# endif
     }
     // Wait for the indicator is stopped or timed out.
     template<class Rep, class Period>
     bool wait_for( const std::chrono::duration<Rep, Period>& time_duration ) const
     {
-      for ( const auto ending = std::chrono::steady_clock::now() + time_duration;
-            std::chrono::steady_clock::now() < ending; ) {
-        if ( !is_running() )
-          return true;
-        std::this_thread::yield();
-      }
-      return false;
+      std::unique_lock<std::mutex> lock { wait_mtx_ };
+      return wait_cond_.wait_for( lock, time_duration, [this]() noexcept { return !is_running(); } );
+    }
+    // Wait for the indicator is stopped or the deadline is reached.
+    template<class Clock, class Duration>
+    bool wait_until( const std::chrono::time_point<Clock, Duration>& deadline ) const
+    {
+      std::unique_lock<std::mutex> lock { wait_mtx_ };
+      return wait_cond_.wait_until( lock, deadline, [this]() noexcept { return !is_running(); } );
     }
   };
 
@@ -4639,10 +7102,187 @@ namespace pgbar {
     template<typename, typename>
     friend struct __detail::render::RenderAction;
 
+    using Sharded = std::integral_constant<bool, std::is_same<MutexMode, Threadsharded>::value>;
+    using Atomic  = std::integral_constant<bool, std::is_same<MutexMode, Threadatomic>::value>;
+
+    /* With `Threadatomic`, the highest bit of `task_cnt_` is set while the bar is accepting lock-free ticks,
+     * and the remaining bits hold the progress. */
+    static constexpr __detail::types::Size open_bit =
+      static_cast<__detail::types::Size>( 1 ) << ( std::numeric_limits<__detail::types::Size>::digits - 1 );
+
     __detail::render::Builder<ConfigType> config_;
     __detail::io::OStream<StreamType> ostream_;
 
     __PGBAR_NOUNIQUEADDR mutable MutexMode mtx_;
+    // Only used by `Threadsharded`.
+    __detail::concurrent::ShardedCounter shards_;
+
+    __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR bool sharded_tick( __detail::types::Size,
+                                                               std::false_type ) noexcept
+    {
+      return false;
+    }
+    /**
+     * Count the ticks without locking if the bar is running with a non-zero number of tasks,
+     * otherwise return false and leave it to the locked path.
+     *
+     * The thread whose flush brings the flushed counter to `task_end_` takes the lock and stops the bar,
+     * the state check under the lock ensures that only one thread does this.
+     */
+    bool sharded_tick( __detail::types::Size num_step, std::true_type )
+    {
+      const auto current_state = this->state_.load( std::memory_order_acquire );
+      const auto task_end      = this->task_end_.load( std::memory_order_acquire );
+      if ( ( current_state != Indicator::state::begin && current_state != Indicator::state::refresh2 )
+           || task_end == 0 )
+        return false;
+
+      /* Once the flushed counter is close enough to the end that all slots together could cover the gap,
+       * every tick drains all slots; so the last increments can't be left in the slot of an idle thread. */
+      const auto tail_zone = shards_.capacity();
+      const auto pending   = shards_.add( num_step );
+      bool drain_all = this->task_cnt_.load( std::memory_order_seq_cst ) + tail_zone >= task_end;
+      if ( pending < __detail::concurrent::ShardedCounter::threshold && !drain_all )
+        return true;
+
+      while ( true ) {
+        const auto flushed = drain_all ? shards_.take_all() : shards_.take();
+        if ( flushed == 0 )
+          return true;
+        const auto task_cnt = this->task_cnt_.fetch_add( flushed, std::memory_order_seq_cst );
+        if ( task_cnt < task_end && task_cnt + flushed >= task_end ) {
+          std::lock_guard<MutexMode> lock { mtx_ };
+          const auto locked_state = this->state_.load( std::memory_order_acquire );
+          if ( ( locked_state == Indicator::state::begin || locked_state == Indicator::state::refresh2 )
+               && this->task_cnt_.load( std::memory_order_acquire )
+                    >= this->task_end_.load( std::memory_order_acquire ) )
+            this->unlock_reset( true );
+          return true;
+        }
+        if ( drain_all || task_cnt + flushed + tail_zone < task_end )
+          return true;
+        drain_all = true;
+      }
+    }
+
+    __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR bool atomic_tick( __detail::types::Size,
+                                                              std::false_type ) noexcept
+    {
+      return false;
+    }
+    /**
+     * Add `num_step` to the packed counter if the bar is accepting lock-free ticks,
+     * otherwise return false and leave it to the locked path.
+     *
+     * The counter never exceeds `task_end_`; the compare-and-swap that brings it to the end also clears
+     * the `open_bit`, so exactly one thread goes on to stop the bar.
+     */
+    bool atomic_tick( __detail::types::Size num_step, std::true_type )
+    {
+      auto task_cnt = this->task_cnt_.load( std::memory_order_acquire );
+      __detail::types::Size task_end, next_cnt;
+      do {
+        if ( !( task_cnt & open_bit ) )
+          return false;
+        // Load it after seeing the `open_bit`, which is set only after `task_end_` is updated.
+        task_end           = this->task_end_.load( std::memory_order_acquire );
+        const auto remains = task_end - ( task_cnt & ~open_bit );
+        next_cnt           = num_step < remains ? ( task_cnt & ~open_bit ) + num_step : task_end;
+      } while ( !this->task_cnt_.compare_exchange_weak( task_cnt,
+                                                        next_cnt < task_end ? next_cnt | open_bit : next_cnt,
+                                                        std::memory_order_acq_rel,
+                                                        std::memory_order_acquire ) );
+
+      __PGBAR_UNLIKELY if ( next_cnt >= task_end )
+      {
+        std::lock_guard<MutexMode> lock { mtx_ };
+        // Another thread may have stopped or restarted the bar before we got the lock.
+        const auto current_state = this->state_.load( std::memory_order_acquire );
+        if ( ( current_state == Indicator::state::begin || current_state == Indicator::state::refresh2 )
+             && this->task_cnt_.load( std::memory_order_acquire ) >= task_end )
+          this->unlock_reset( true );
+      }
+      return true;
+    }
+
+    // Both must be called with the lock held.
+    __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR void atomic_close( std::false_type ) noexcept {}
+    __PGBAR_INLINE_FN void atomic_close( std::true_type ) noexcept
+    {
+      this->task_cnt_.fetch_and( ~open_bit, std::memory_order_acq_rel );
+    }
+    __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR void atomic_open( std::false_type ) noexcept {}
+    __PGBAR_INLINE_FN void atomic_open( std::true_type ) noexcept
+    {
+      const auto current_state = this->state_.load( std::memory_order_acquire );
+      const auto task_end      = this->task_end_.load( std::memory_order_acquire );
+      if ( ( current_state == Indicator::state::begin || current_state == Indicator::state::refresh2 )
+           && this->task_cnt_.load( std::memory_order_acquire ) < task_end )
+        this->task_cnt_.fetch_or( open_bit, std::memory_order_acq_rel );
+    }
+
+    __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR void sharded_prepare( std::false_type ) noexcept {}
+    // Must be called with the lock held.
+    __PGBAR_INLINE_FN void sharded_prepare( std::true_type )
+    {
+      const auto current_state = this->state_.load( std::memory_order_acquire );
+      if ( current_state == Indicator::state::stopped )
+        shards_.clear();
+      else if ( current_state == Indicator::state::begin
+                || current_state == Indicator::state::refresh2 )
+        this->task_cnt_.fetch_add( shards_.take_all(), std::memory_order_acq_rel );
+    }
+
+    __PGBAR_NODISCARD __PGBAR_INLINE_FN __detail::types::Size sharded_progress(
+      std::false_type ) const noexcept
+    {
+      return Atomic::value ? this->task_cnt_.load( std::memory_order_acquire ) & ~open_bit
+                           : this->task_cnt_.load( std::memory_order_acquire );
+    }
+    __PGBAR_NODISCARD __detail::types::Size sharded_progress( std::true_type ) const noexcept
+    {
+      const auto task_end = this->task_end_.load( std::memory_order_acquire );
+      const auto task_cnt = this->task_cnt_.load( std::memory_order_acquire ) + shards_.sum();
+      return task_cnt < task_end ? task_cnt : task_end;
+    }
+
+    // Set by `observe()`; the render thread samples it before drawing each frame.
+    std::unique_ptr<__detail::wrappers::ProgressFn> observer_;
+    std::atomic<bool> observing_ { false };
+
+    // The task of the render thread.
+    void render()
+    {
+      const auto current_state = this->state_.load( std::memory_order_acquire );
+      if ( current_state == Indicator::state::finish )
+        observing_.store( false, std::memory_order_release );
+      else if ( observing_.load( std::memory_order_acquire ) && current_state != Indicator::state::stopped ) {
+        const auto task_end = this->task_end_.load( std::memory_order_acquire );
+        const auto sample   = observer_->run();
+        this->task_cnt_.store( task_end != 0 && sample > task_end ? task_end : sample,
+                               std::memory_order_release );
+
+        /* The thread can't call `unlock_reset` on itself, as `suspend` waits for the thread;
+         * so it moves the bar to `finish` and pauses, then draws the last frame below. */
+        auto try_update = [this]( Indicator::state expected ) noexcept {
+          return this->state_.compare_exchange_strong( expected,
+                                                       Indicator::state::finish,
+                                                       std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed );
+        };
+        if ( task_end != 0 && sample >= task_end
+             && ( try_update( Indicator::state::begin ) || try_update( Indicator::state::refresh2 ) ) ) {
+          observing_.store( false, std::memory_order_release );
+          this->final_mesg_ = true;
+          this->executor_.pause();
+        }
+      }
+
+      if ( config::Core::intty( StreamType ) )
+        __detail::render::RenderAction<ConfigType>::rendering( *this );
+      else if ( this->state_.load( std::memory_order_acquire ) == Indicator::state::finish )
+        this->stop();
+    }
 
   public:
     BasicBar( ConfigType config = ConfigType() )
@@ -4673,25 +7313,29 @@ namespace pgbar {
     }
     virtual ~BasicBar() noexcept { this->executor_.reset(); }
 
-    self& tick() & override final
-    {
-      std::lock_guard<MutexMode> lock { mtx_ };
-      __detail::render::TickAction<ConfigType>::template do_tick<StreamType>(
-        *this,
-        [this]() noexcept -> void { this->task_cnt_.fetch_add( 1, std::memory_order_release ); } );
-      return *this;
-    }
+    // The same as `tick( 1 )`, which also keeps a concurrent sharded flush from making it overshoot.
+    self& tick() & override final { return tick( 1 ); }
     self& tick( __detail::types::Size next_step ) & override final
     {
+      if ( sharded_tick( next_step, Sharded() ) || atomic_tick( next_step, Atomic() ) )
+        return *this;
       std::lock_guard<MutexMode> lock { mtx_ };
+      sharded_prepare( Sharded() );
+      atomic_close( Atomic() );
       __detail::render::TickAction<ConfigType>::template do_tick<StreamType>(
         *this,
         [this, next_step]() noexcept -> void {
-          const auto task_cnt = this->task_cnt_.load( std::memory_order_acquire );
           const auto task_end = this->task_end_.load( std::memory_order_acquire );
-          this->task_cnt_.fetch_add( next_step + task_cnt > task_end ? task_end - task_cnt : next_step,
-                                     std::memory_order_release );
+          // A single compare-and-swap, so that a concurrent sharded flush can't make it overshoot.
+          auto task_cnt = this->task_cnt_.load( std::memory_order_acquire );
+          while ( task_cnt < task_end
+                  && !this->task_cnt_.compare_exchange_weak(
+                    task_cnt,
+                    next_step < task_end - task_cnt ? task_cnt + next_step : task_end,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire ) ) {}
         } );
+      atomic_open( Atomic() );
       return *this;
     }
     /**
@@ -4704,6 +7348,8 @@ namespace pgbar {
     self& tick_to( __detail::types::Size percentage ) & override final
     {
       std::lock_guard<MutexMode> lock { mtx_ };
+      sharded_prepare( Sharded() );
+      atomic_close( Atomic() );
       __detail::render::TickAction<ConfigType>::template do_tick<StreamType>(
         *this,
         [this, percentage]() noexcept -> void {
@@ -4713,11 +7359,17 @@ namespace pgbar {
 
             __PGBAR_ASSERT( target_progress <= this->task_end_ );
 
-            if ( target_progress > this->task_cnt_.load( std::memory_order_acquire ) )
-              this->task_cnt_.store( target_progress, std::memory_order_release );
+            // The sharded ticks may still flush into the counter while holding no lock.
+            auto task_cnt = this->task_cnt_.load( std::memory_order_acquire );
+            while ( target_progress > task_cnt
+                    && !this->task_cnt_.compare_exchange_weak( task_cnt,
+                                                               target_progress,
+                                                               std::memory_order_acq_rel,
+                                                               std::memory_order_acquire ) ) {}
           } else
             this->task_cnt_.store( task_end, std::memory_order_release );
         } );
+      atomic_open( Atomic() );
       return *this;
     }
 
@@ -4728,14 +7380,163 @@ namespace pgbar {
     void reset() override final
     {
       std::lock_guard<MutexMode> lock { mtx_ };
+      atomic_close( Atomic() );
+      observing_.store( false, std::memory_order_release );
       this->unlock_reset( true );
     }
     void reset( bool final_mesg ) override final
     {
       std::lock_guard<MutexMode> lock { mtx_ };
+      atomic_close( Atomic() );
+      observing_.store( false, std::memory_order_release );
       this->unlock_reset( final_mesg );
     }
 
+    /**
+     * Start the bar and let it follow a progress that is counted elsewhere,
+     * instead of being ticked: the render thread calls `sampler` before drawing each frame,
+     * and the bar stops by itself once the returned value reaches the number of tasks.
+     *
+     * The sampler is called by the render thread only, it must stay valid until the bar stops;
+     * the bar must not be ticked while it is being observed.
+     *
+     * @throw exception::InvalidState If the bar is already running.
+     */
+    template<typename F,
+             typename = typename std::enable_if<std::is_convertible<
+               decltype( std::declval<typename std::decay<F>::type&>()() ),
+               __detail::types::Size>::value>::type>
+    self& observe( F&& sampler ) &
+    {
+      std::lock_guard<MutexMode> lock { mtx_ };
+      __PGBAR_UNLIKELY if ( this->is_running() ) throw exception::InvalidState(
+        "pgbar: the bar is already running" );
+
+      using Wrapper = __detail::wrappers::ProgressFnWrapper<typename std::decay<F>::type>;
+      observer_.reset( new Wrapper( std::forward<F>( sampler ) ) );
+      observing_.store( true, std::memory_order_release );
+      sharded_prepare( Sharded() );
+      try {
+        // The progress is left to the render thread, which is the only caller of the sampler.
+        __detail::render::TickAction<ConfigType>::template do_tick<StreamType>( *this,
+                                                                                []() noexcept -> void {} );
+      } catch ( ... ) {
+        observing_.store( false, std::memory_order_release );
+        throw;
+      }
+      return *this;
+    }
+    // Observe an atomic counter that other threads increase.
+    self& observe( const std::atomic<__detail::types::Size>& counter ) &
+    {
+      return observe( [&counter]() noexcept -> __detail::types::Size {
+        return counter.load( std::memory_order_acquire );
+      } );
+    }
+
+    // Get the progress of the task.
+    __PGBAR_NODISCARD __detail::types::Size progress() const noexcept
+    {
+      return sharded_progress( Sharded() );
+    }
+
+    /**
+     * A handle that counts the ticks of one thread in a plain local integer,
+     * and publishes them to the bar through `tick( Size )`
+     * every `batch_size` ticks, when the time budget expires, or when it is destroyed.
+     *
+     * Each thread should create its own handle; a handle must not outlive its bar.
+     */
+    class LocalTicker final {
+      self* bar_;
+      __detail::types::Size pending_;
+      __detail::types::Size batch_size_;
+      __detail::types::TimeUnit budget_;
+      std::chrono::steady_clock::time_point last_flush_;
+
+      __PGBAR_INLINE_FN bool expired() const
+      {
+        return config::Core::now() - last_flush_ >= budget_;
+      }
+
+    public:
+      LocalTicker( self& bar, __detail::types::Size batch_size, __detail::types::TimeUnit budget ) noexcept
+        : bar_ { std::addressof( bar ) }
+        , pending_ { 0 }
+        , batch_size_ { batch_size == 0 ? 1 : batch_size }
+        , budget_ { std::move( budget ) }
+        , last_flush_ { config::Core::now() }
+      {}
+      LocalTicker( const LocalTicker& ) = delete;
+      LocalTicker( LocalTicker&& rhs ) noexcept
+        : bar_ { rhs.bar_ }
+        , pending_ { rhs.pending_ }
+        , batch_size_ { rhs.batch_size_ }
+        , budget_ { rhs.budget_ }
+        , last_flush_ { rhs.last_flush_ }
+      {
+        rhs.bar_     = nullptr;
+        rhs.pending_ = 0;
+      }
+      LocalTicker& operator=( const LocalTicker& ) = delete;
+      LocalTicker& operator=( LocalTicker&& )      = delete;
+      // Any exception thrown by the last publication is discarded, call `flush()` first to observe it.
+      ~LocalTicker() noexcept
+      {
+        try {
+          flush();
+        } catch ( ... ) {
+        }
+      }
+
+      __PGBAR_INLINE_FN LocalTicker& tick() &
+      {
+        ++pending_;
+        /* Reading the clock costs more than the tick itself,
+         * so the budget is only checked when the pending count reaches a power of two. */
+        if ( pending_ >= batch_size_ || ( ( pending_ & ( pending_ - 1 ) ) == 0 && expired() ) )
+          flush();
+        return *this;
+      }
+      __PGBAR_INLINE_FN LocalTicker& tick( __detail::types::Size next_step ) &
+      {
+        pending_ += next_step;
+        if ( pending_ >= batch_size_ || expired() )
+          flush();
+        return *this;
+      }
+
+      // Publish the pending ticks to the bar.
+      void flush()
+      {
+        if ( bar_ == nullptr || pending_ == 0 )
+          return;
+        const auto num_step = pending_;
+        pending_            = 0;
+        last_flush_         = config::Core::now();
+        bar_->tick( num_step );
+      }
+
+      // Get the number of ticks that haven't been published yet.
+      __PGBAR_NODISCARD __detail::types::Size pending() const noexcept { return pending_; }
+    };
+
+    /**
+     * Create a handle that accumulates ticks locally,
+     * the default time budget is the refresh interval of the bar.
+     *
+     * @param batch_size The number of ticks accumulated before they are published.
+     */
+    __PGBAR_NODISCARD LocalTicker local_ticker( __detail::types::Size batch_size = 64 ) &
+    {
+      return LocalTicker( *this, batch_size, config_.interval() );
+    }
+    __PGBAR_NODISCARD LocalTicker local_ticker( __detail::types::Size batch_size,
+                                                __detail::types::TimeUnit budget ) & noexcept
+    {
+      return LocalTicker( *this, batch_size, std::move( budget ) );
+    }
+
     ConfigType& config() & noexcept { return config_; }
     const ConfigType& config() const& noexcept { return config_; }
     ConfigType config() && noexcept { return std::move( config_ ); }
@@ -4795,16 +7596,24 @@ namespace pgbar {
         {
           switch ( bar.state_.load( std::memory_order_acquire ) ) {
           case BarType::state::begin: {
-            __PGBAR_ASSERT( bar.task_cnt_ <= bar.task_end_ );
+            __PGBAR_ASSERT( bar.progress() <= bar.task_end_ );
             bar.idx_frame_    = 0;
             bar.max_bar_size_ = bar.config_.full_render_size();
             bar.ostream_.reserve( bar.max_bar_size_ * 1.2 ) << console::escape::store_cursor;
-            bar.config_.build( bar.ostream_,
+            const auto num_task_done = bar.progress();
+            // Read before the frame is built, so a change made meanwhile is drawn by the next refresh.
+            const auto generation = bar.config_.generation();
+            bar.config_.build( bar.painter_.canvas(),
                                bar.idx_frame_,
-                               bar.task_cnt_.load( std::memory_order_acquire ),
+                               num_task_done,
                                bar.task_end_.load( std::memory_order_acquire ),
                                bar.zero_point_ );
+            bar.painter_.draw( bar.ostream_ );
             bar.ostream_ << io::flush;
+            bar.tracker_.reset( num_task_done,
+                                FrameTracker::seconds_since( bar.zero_point_ ),
+                                bar.config_.animation_frame( bar.idx_frame_ ),
+                                generation );
 
             auto expected = BarType::state::begin;
             if __PGBAR_CXX17_CNSTXPR ( std::is_same<ConfigType, config::CharBar>::value )
@@ -4827,35 +7636,44 @@ namespace pgbar {
 
           case BarType::state::refresh1: __PGBAR_FALLTHROUGH;
           case BarType::state::refresh2: {
-            __PGBAR_ASSERT( bar.task_cnt_ <= bar.task_end_ );
-            bar.max_bar_size_ = std::max( bar.max_bar_size_, bar.config_.full_render_size() );
-            bar.ostream_ << console::escape::restore_cursor
-                         << console::escape::clear_next( bar.max_bar_size_ );
+            const auto num_task_done = bar.progress();
+            __PGBAR_ASSERT( num_task_done <= bar.task_end_ );
+            // The animation keeps its pace even if the frame is skipped.
+            const auto idx_frame  = bar.idx_frame_++;
+            const auto generation = bar.config_.generation();
+            if ( bar.tracker_.idle( num_task_done, generation ) )
+              break;
+            if ( !bar.tracker_.update( num_task_done,
+                                       FrameTracker::seconds_since( bar.zero_point_ ),
+                                       bar.config_.animation_frame( idx_frame ),
+                                       generation ) )
+              break;
 
-            bar.config_.build( bar.ostream_,
-                               bar.idx_frame_,
-                               bar.task_cnt_.load( std::memory_order_acquire ),
+            bar.max_bar_size_ = std::max( bar.max_bar_size_, bar.config_.full_render_size() );
+            bar.config_.build( bar.painter_.canvas(),
+                               idx_frame,
+                               num_task_done,
                                bar.task_end_.load( std::memory_order_acquire ),
                                bar.zero_point_ );
+            bar.painter_.redraw( bar.ostream_, bar.max_bar_size_ );
             bar.ostream_ << io::flush;
-            ++bar.idx_frame_;
           } break;
 
           case BarType::state::finish: { // intermediate state
-            __PGBAR_ASSERT( bar.task_cnt_ <= bar.task_end_ );
+            __PGBAR_ASSERT( bar.progress() <= bar.task_end_ );
             bar.max_bar_size_ = std::max( bar.max_bar_size_, bar.config_.full_render_size() );
             bar.ostream_ << console::escape::restore_cursor
                          << console::escape::clear_next( bar.max_bar_size_ );
 
             bar.config_.build( bar.ostream_,
                                bar.idx_frame_,
-                               bar.task_cnt_.load( std::memory_order_acquire ),
+                               bar.progress(),
                                bar.task_end_.load( std::memory_order_acquire ),
                                bar.final_mesg_,
                                bar.zero_point_ )
               << '\n';
-            bar.ostream_ << io::flush << io::release;
-            bar.state_.store( BarType::state::stopped, std::memory_order_release );
+            bar.ostream_ << io::flush;
+            bar.stop();
           } break;
 
           default: return;
@@ -4870,15 +7688,22 @@ namespace pgbar {
         {
           switch ( bar.state_.load( std::memory_order_acquire ) ) {
           case BarType::state::begin: {
-            __PGBAR_ASSERT( bar.task_cnt_ == 0 );
+            __PGBAR_ASSERT( bar.progress() <= bar.task_end_ );
             bar.max_bar_size_ = bar.config_.full_render_size();
             bar.ostream_.reserve( bar.max_bar_size_ * 1.2 ) << console::escape::store_cursor;
 
-            bar.config_.build( bar.ostream_,
-                               bar.task_cnt_.load( std::memory_order_acquire ),
+            const auto num_task_done = bar.progress();
+            const auto generation    = bar.config_.generation();
+            bar.config_.build( bar.painter_.canvas(),
+                               num_task_done,
                                bar.task_end_.load( std::memory_order_acquire ),
                                bar.zero_point_ );
+            bar.painter_.draw( bar.ostream_ );
             bar.ostream_ << io::flush;
+            bar.tracker_.reset( num_task_done,
+                                FrameTracker::seconds_since( bar.zero_point_ ),
+                                0,
+                                generation );
 
             auto expected = BarType::state::begin;
             bar.state_.compare_exchange_strong( expected,
@@ -4889,32 +7714,39 @@ namespace pgbar {
             __PGBAR_FALLTHROUGH;
 
           case BarType::state::refresh2: {
-            __PGBAR_ASSERT( bar.task_cnt_ <= bar.task_end_ );
-            bar.max_bar_size_ = std::max( bar.max_bar_size_, bar.config_.full_render_size() );
-            bar.ostream_ << console::escape::restore_cursor
-                         << console::escape::clear_next( bar.max_bar_size_ );
+            const auto num_task_done = bar.progress();
+            __PGBAR_ASSERT( num_task_done <= bar.task_end_ );
+            const auto generation = bar.config_.generation();
+            if ( bar.tracker_.idle( num_task_done, generation )
+                 || !bar.tracker_.update( num_task_done,
+                                          FrameTracker::seconds_since( bar.zero_point_ ),
+                                          0,
+                                          generation ) )
+              break;
 
-            bar.config_.build( bar.ostream_,
-                               bar.task_cnt_.load( std::memory_order_acquire ),
+            bar.max_bar_size_ = std::max( bar.max_bar_size_, bar.config_.full_render_size() );
+            bar.config_.build( bar.painter_.canvas(),
+                               num_task_done,
                                bar.task_end_.load( std::memory_order_acquire ),
                                bar.zero_point_ );
+            bar.painter_.redraw( bar.ostream_, bar.max_bar_size_ );
             bar.ostream_ << io::flush;
           } break;
 
           case BarType::state::finish: {
-            __PGBAR_ASSERT( bar.task_cnt_ <= bar.task_end_ );
+            __PGBAR_ASSERT( bar.progress() <= bar.task_end_ );
             bar.max_bar_size_ = std::max( bar.max_bar_size_, bar.config_.full_render_size() );
             bar.ostream_ << console::escape::restore_cursor
                          << console::escape::clear_next( bar.max_bar_size_ );
 
             bar.config_.build( bar.ostream_,
-                               bar.task_cnt_.load( std::memory_order_acquire ),
+                               bar.progress(),
                                bar.task_end_.load( std::memory_order_acquire ),
                                bar.final_mesg_,
                                bar.zero_point_ )
               << '\n';
-            bar.ostream_ << io::flush << io::release;
-            bar.state_.store( BarType::state::stopped, std::memory_order_release );
+            bar.ostream_ << io::flush;
+            bar.stop();
           } break;
 
           default: return;
@@ -4939,19 +7771,23 @@ namespace pgbar {
               InvalidState( "pgbar: the number of tasks is zero" );
 
             bar.task_cnt_.store( 0, std::memory_order_release );
-            bar.zero_point_ = std::chrono::steady_clock::now();
+            bar.zero_point_ = config::Core::now();
             bar.state_.store( BarType::state::begin, std::memory_order_release );
 
             /* If the standard output stream isn't bound to a tty,
              * we shouldn't activate the render thread.
 
              * However, in order to maintain semantic consistency,
-             * exception checking and task counter updating are always carried out. */
-            if ( config::Core::intty( StreamType ) ) {
-              __PGBAR_UNLIKELY if ( !bar.executor_.valid() )
-                bar.executor_.reset( [&bar]() { RenderAction<ConfigType>::rendering( bar ); } );
+             * exception checking and task counter updating are always carried out.
+
+             * An observed bar needs the thread anyway to sample its progress;
+             * once created, the thread must run every time since `unlock_reset` waits for it. */
+            __PGBAR_UNLIKELY if ( ( config::Core::intty( StreamType )
+                                    || bar.observing_.load( std::memory_order_acquire ) )
+                                  && !bar.executor_.valid() )
+              bar.executor_.reset( [&bar]() { bar.render(); }, std::addressof( bar.config_ ) );
+            if ( bar.executor_.valid() )
               bar.executor_.activate();
-            }
           }
             __PGBAR_FALLTHROUGH;
           case BarType::state::begin:    __PGBAR_FALLTHROUGH;
@@ -4981,14 +7817,15 @@ namespace pgbar {
           case BarType::state::stopped: {
             bar.task_end_.store( bar.config_.tasks(), std::memory_order_release );
             bar.task_cnt_.store( 0, std::memory_order_release );
-            bar.zero_point_ = std::chrono::steady_clock::now();
+            bar.zero_point_ = config::Core::now();
             bar.state_.store( BarType::state::begin, std::memory_order_release );
 
-            if ( config::Core::intty( StreamType ) ) {
-              __PGBAR_UNLIKELY if ( !bar.executor_.valid() )
-                bar.executor_.reset( [&bar]() { RenderAction<ConfigType>::rendering( bar ); } );
+            __PGBAR_UNLIKELY if ( ( config::Core::intty( StreamType )
+                                    || bar.observing_.load( std::memory_order_acquire ) )
+                                  && !bar.executor_.valid() )
+              bar.executor_.reset( [&bar]() { bar.render(); }, std::addressof( bar.config_ ) );
+            if ( bar.executor_.valid() )
               bar.executor_.activate();
-            }
           }
             __PGBAR_FALLTHROUGH;
 
@@ -5019,6 +7856,9 @@ namespace pgbar {
         B,
         void_t<decltype( std::declval<B&>().config().tasks( std::declval<types::Size>() ) )>>
         : std::true_type {};
+
+      template<typename ConfigType, StreamChannel StreamType>
+      struct is_threadunsafe_bar<BasicBar<ConfigType, Threadunsafe, StreamType>> : std::true_type {};
     }
   } // namespace __detail
 
@@ -5026,9 +7866,16 @@ namespace pgbar {
     /**
      * A range that contains a bar object and an unidirectional abstract range,
      * which transforms the iterations in the abstract into a visual display of the object.
+     *
+     * Since C++20, it is a `std::ranges::view`, so it can be composed with the range adaptors;
+     * it's a common range, whose `end()` is an iterator as well.
      */
     template<typename R, typename B>
+# if __PGBAR_CXX20
+    class ProxySpan : public std::ranges::view_interface<ProxySpan<R, B>> {
+# else
     class ProxySpan {
+# endif
       static_assert( __detail::trait::is_arith_range<R>::value || __detail::trait::is_iter_range<R>::value,
                      "pgbar::iterators::ProxySpan: Only available for certain range types" );
       static_assert( __detail::trait::is_iterable_bar<B>::value,
@@ -5038,46 +7885,220 @@ namespace pgbar {
       B* itr_bar_;
       R itr_range_;
 
+      /**
+       * The progress of the iterators created by one call to `begin()`, which is shared by all their copies.
+       *
+       * It follows the furthest position any of them has reached, so copies that move over the same elements,
+       * or jump backwards and forwards again, never count anything twice.
+       * The iterators only report at checkpoints, where the clock is read; the progress made since the last
+       * update is published through `tick( Size )` once a refresh interval has passed, and always at the end.
+       * The distance between two checkpoints starts at 1 and is sized by the time the last one took,
+       * so that the clock is read a few times per refresh interval however cheap the loop body is.
+       */
+      class Progress final {
+        /**
+         * The upper limit of the distance between two checkpoints.
+         * If the loop body suddenly slows down, the next update is late by at most this many slow steps,
+         * after which the distance shrinks in proportion to the slowdown.
+         */
+        static constexpr __detail::types::Size max_stride = 1 << 10;
+
+        B* itr_bar_;
+        __detail::types::Size num_tasks_;
+        __detail::types::Size reached_;
+        __detail::types::Size published_;
+        __detail::types::Size checkpoint_;
+        __detail::types::Size stride_;
+        __detail::types::TimeUnit interval_;
+        std::chrono::steady_clock::time_point last_check_;
+        std::chrono::steady_clock::time_point last_publish_;
+
+        void check()
+        {
+          __PGBAR_ASSERT( itr_bar_ != nullptr );
+          const auto now     = config::Core::now();
+          const auto elapsed = now - last_check_;
+          last_check_        = now;
+          // The iterators may be moved past the end, which isn't progress.
+          const auto reached = ( std::min )( reached_, num_tasks_ );
+          // The first step is published at once, so that the bar starts moving with the loop.
+          if ( reached > published_
+               && ( published_ == 0 || reached == num_tasks_ || now - last_publish_ >= interval_ ) ) {
+            const auto num_step = reached - published_;
+            published_          = reached;
+            last_publish_       = now;
+            itr_bar_->tick( num_step );
+          }
+
+          // Aim at a distance that takes between an eighth and a quarter of the refresh interval.
+          if ( elapsed < interval_ / 8 ) {
+            if ( stride_ < max_stride )
+              stride_ *= 2;
+          } else if ( elapsed > interval_ / 4 )
+            stride_ = ( std::max<__detail::types::Size> )( 1, stride_ * ( interval_ / 4 ) / elapsed );
+          checkpoint_ = num_tasks_ - reached > stride_ ? reached + stride_ : num_tasks_;
+        }
+
+      public:
+        // The checkpoint of the iterators that never report anything.
+        __PGBAR_NODISCARD static constexpr __detail::types::Size no_checkpoint() noexcept
+        {
+          return ( std::numeric_limits<__detail::types::Size>::max )();
+        }
+
+        Progress() noexcept { reset( nullptr, 0, {} ); }
+
+        void reset( B* itr_bar, __detail::types::Size num_tasks, __detail::types::TimeUnit interval ) noexcept
+        {
+          itr_bar_      = itr_bar;
+          num_tasks_    = num_tasks;
+          reached_      = 0;
+          published_    = 0;
+          checkpoint_   = ( std::min<__detail::types::Size> )( num_tasks, 1 );
+          stride_       = 1;
+          interval_     = std::move( interval );
+          last_check_   = config::Core::now();
+          last_publish_ = last_check_;
+        }
+
+        /**
+         * Called when an iterator moves forward to `position` at or past the checkpoint it knows of,
+         * returns the checkpoint at which it should report again.
+         */
+        __detail::types::Size reach( __detail::types::Size position )
+        {
+          if ( position > reached_ ) {
+            reached_ = position;
+            if ( position >= checkpoint_ && published_ < num_tasks_ )
+              check();
+          }
+          return checkpoint();
+        }
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN __detail::types::Size checkpoint() const noexcept
+        {
+          return published_ < num_tasks_ ? checkpoint_ : no_checkpoint();
+        }
+      };
+
+      // Mutable so that `end()` can hand out iterators, which never move the progress though.
+      mutable Progress progress_;
+
     public:
+      /**
+       * The iterator keeps the category of the underlying iterator, and remembers the next checkpoint
+       * of the `Progress` of the span that created it; it only reports to the `Progress` once it gets there,
+       * so each step costs one comparison against that checkpoint.
+       *
+       * The iterators returned by `end()` and the default constructed ones report nothing,
+       * so moving them around never ticks the bar.
+       * They are invalidated if the span is moved or destroyed.
+       */
       class iterator final {
-        typename R::iterator itr_;
-        B* itr_bar_;
+        using Itr = typename R::iterator;
+
+        Itr itr_;
+        Progress* progress_;
+        __detail::types::Size position_;
+        __detail::types::Size checkpoint_;
+
+        __PGBAR_INLINE_FN void advanced()
+        {
+          __PGBAR_UNLIKELY if ( position_ >= checkpoint_ ) checkpoint_ = progress_->reach( position_ );
+        }
 
       public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type        = typename std::iterator_traits<typename R::iterator>::value_type;
-        using difference_type   = void;
-        using pointer           = typename std::iterator_traits<typename R::iterator>::pointer;
-        using reference         = typename std::iterator_traits<typename R::iterator>::reference;
-
-        __PGBAR_CXX17_CNSTXPR iterator( typename R::iterator itr, B& itr_bar )
-          noexcept( std::is_nothrow_move_constructible<typename R::iterator>::value )
-          : itr_ { std::move( itr ) }, itr_bar_ { std::addressof( itr_bar ) }
+        using iterator_category = typename std::iterator_traits<Itr>::iterator_category;
+# if __PGBAR_CXX20
+        using iterator_concept =
+          std::conditional_t<std::contiguous_iterator<Itr>, std::contiguous_iterator_tag, iterator_category>;
+# endif
+        using value_type = typename std::iterator_traits<Itr>::value_type;
+        // The range adaptors need a signed integer here, which the numeric iterator doesn't provide.
+        using difference_type = typename std::conditional<
+          std::is_integral<typename std::iterator_traits<Itr>::difference_type>::value
+            && std::is_signed<typename std::iterator_traits<Itr>::difference_type>::value,
+          typename std::iterator_traits<Itr>::difference_type,
+          std::ptrdiff_t>::type;
+        using pointer   = typename std::iterator_traits<Itr>::pointer;
+        using reference = typename std::iterator_traits<Itr>::reference;
+
+        iterator() noexcept( std::is_nothrow_default_constructible<Itr>::value )
+          : iterator( Itr(), nullptr, 0 )
+        {}
+        iterator( Itr itr, Progress* progress, __detail::types::Size position )
+          noexcept( std::is_nothrow_move_constructible<Itr>::value )
+          : itr_ { std::move( itr ) }
+          , progress_ { progress }
+          , position_ { position }
+          , checkpoint_ { progress != nullptr ? progress->checkpoint() : Progress::no_checkpoint() }
         {}
         __PGBAR_CXX20_CNSTXPR ~iterator() noexcept( std::is_nothrow_destructible<R>::value ) = default;
 
-        __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator& operator++()
+        __PGBAR_INLINE_FN iterator& operator++()
         {
-          __PGBAR_ASSERT( itr_bar_ != nullptr );
           ++itr_;
-          itr_bar_->tick();
+          ++position_;
+          advanced();
           return *this;
         }
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR iterator operator++( int )
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN iterator operator++( int )
         {
-          __PGBAR_ASSERT( itr_bar_ != nullptr );
           auto before = *this;
           operator++();
           return before;
         }
-
-        __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX14_CNSTXPR reference operator*() noexcept
+        // Moving backwards never takes back the published progress.
+        __PGBAR_INLINE_FN iterator& operator--()
+        {
+          --itr_;
+          --position_;
+          return *this;
+        }
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN iterator operator--( int )
+        {
+          auto before = *this;
+          operator--();
+          return before;
+        }
+        iterator& operator+=( difference_type increment )
+        {
+          itr_ += increment;
+          if ( increment < 0 )
+            position_ -= static_cast<__detail::types::Size>( -increment );
+          else {
+            position_ += static_cast<__detail::types::Size>( increment );
+            advanced();
+          }
+          return *this;
+        }
+        __PGBAR_INLINE_FN iterator& operator-=( difference_type decrement ) { return *this += -decrement; }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN iterator operator+( iterator itr, difference_type n )
+        {
+          return itr += n;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN iterator operator+( difference_type n, iterator itr )
         {
-          return *itr_;
+          return itr += n;
         }
-        __PGBAR_INLINE_FN __PGBAR_CXX17_CNSTXPR pointer operator->() noexcept
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN iterator operator-( iterator itr, difference_type n )
         {
-          return std::addressof( itr_ );
+          return itr -= n;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr difference_type operator-( const iterator& a,
+                                                                                        const iterator& b )
+# if __PGBAR_CXX20
+          requires std::sized_sentinel_for<Itr, Itr>
+# endif
+        {
+          return a.itr_ - b.itr_;
+        }
+
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr reference operator*() const { return *itr_; }
+        __PGBAR_INLINE_FN constexpr pointer operator->() const { return itr_.operator->(); }
+        // Accessing an element by index doesn't count as progress.
+        __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr reference operator[]( difference_type n ) const
+        {
+          return itr_[n];
         }
         __PGBAR_NODISCARD __PGBAR_INLINE_FN constexpr bool operator==(
           const typename R::iterator& lhs ) const noexcept
@@ -5099,6 +8120,26 @@ namespace pgbar {
         {
           return !( a == b );
         }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator<( const iterator& a,
+                                                                             const iterator& b )
+        {
+          return a.itr_ < b.itr_;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator>( const iterator& a,
+                                                                             const iterator& b )
+        {
+          return b < a;
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator<=( const iterator& a,
+                                                                              const iterator& b )
+        {
+          return !( b < a );
+        }
+        __PGBAR_NODISCARD friend __PGBAR_INLINE_FN constexpr bool operator>=( const iterator& a,
+                                                                              const iterator& b )
+        {
+          return !( a < b );
+        }
       };
 
       __PGBAR_CXX17_CNSTXPR ProxySpan( R itr_range, B& itr_bar )
@@ -5122,15 +8163,19 @@ namespace pgbar {
 
       /**
        * This function CHANGES the state of the pgbar object it holds.
+       *
+       * Leaving the loop early may leave the last batch of iterations unpublished.
        */
-      __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX17_CNSTXPR iterator begin() &
+      __PGBAR_NODISCARD __PGBAR_INLINE_FN iterator begin() &
       {
         itr_bar_->config().tasks( itr_range_.size() );
-        return iterator( itr_range_.begin(), *itr_bar_ );
+        progress_.reset( itr_bar_, itr_range_.size(), itr_bar_->config().interval() );
+        return iterator( itr_range_.begin(), std::addressof( progress_ ), 0 );
       }
+      // Returns an iterator that never ticks.
       __PGBAR_NODISCARD __PGBAR_INLINE_FN __PGBAR_CXX17_CNSTXPR iterator end() const
       {
-        return iterator( itr_range_.end(), *itr_bar_ );
+        return iterator( itr_range_.end(), nullptr, itr_range_.size() );
       }
 
       __PGBAR_CXX20_CNSTXPR void swap( ProxySpan<R, B>& lhs ) noexcept
@@ -5187,6 +8232,7 @@ namespace pgbar {
 # undef __PGBAR_CXX14
 # undef __PGBAR_CXX14_CNSTXPR
 # undef __PGBAR_CXX11
+# undef __PGBAR_SIMD
 
 # undef __PGBAR_BLACK
 # undef __PGBAR_RED
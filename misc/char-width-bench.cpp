@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "pgbar/pgbar.hpp"
+
+/**
+ * This file compares the lookup speed of `U8String::char_width`, which reads the generated
+ * two-level table, with the `lower_bound` search over the former 47 code charts
+ * and with the `if-else` version in misc/UTF-8-test.cpp.
+ * It also counts the code points on which the former code charts disagree with the table.
+ *
+ * Build: g++ -std=c++11 -O2 -I ../include char-width-bench.cpp -o char-width-bench
+ */
+
+using pgbar::__detail::types::Size;
+using pgbar::__detail::types::UCodePoint;
+
+struct CodeChart {
+  UCodePoint start, end;
+  Size width;
+};
+
+const CodeChart code_charts[] = {
+    { 0x0, 0x19, 0 },        { 0x20, 0x7E, 1 },       { 0x7F, 0xA0, 0 },      { 0xA1, 0xAC, 1 },
+    { 0xAD, 0xAD, 0 },       { 0xAE, 0x2FF, 1 },      { 0x300, 0x36F, 0 },    { 0x370, 0x1FFF, 1 },
+    { 0x2000, 0x200F, 0 },   { 0x2010, 0x2010, 1 },   { 0x2011, 0x2011, 0 },  { 0x2012, 0x2027, 1 },
+    { 0x2028, 0x202F, 0 },   { 0x2030, 0x205E, 1 },   { 0x205F, 0x206F, 0 },  { 0x2070, 0x2E7F, 1 },
+    { 0x2E80, 0xA4CF, 2 },   { 0xA4D0, 0xA95F, 1 },   { 0xA960, 0xA97F, 2 },  { 0xA980, 0xABFF, 1 },
+    { 0xAC00, 0xD7FF, 2 },   { 0xE000, 0xF8FF, 2 },   { 0xF900, 0xFAFF, 2 },  { 0xFB00, 0xFDCF, 1 },
+    { 0xFDD0, 0xFDEF, 0 },   { 0xFDF0, 0xFDFF, 1 },   { 0xFE00, 0xFE0F, 0 },  { 0xFE10, 0xFE1F, 2 },
+    { 0xFE20, 0xFE2F, 0 },   { 0xFE30, 0xFE6F, 2 },   { 0xFE70, 0xFEFE, 1 },  { 0xFEFF, 0xFEFF, 0 },
+    { 0xFF00, 0xFF60, 2 },   { 0xFF61, 0xFFDF, 1 },   { 0xFFE0, 0xFFE6, 2 },  { 0xFFE7, 0xFFEF, 1 },
+    { 0xFFF0, 0xFFFF, 1 },   { 0x10000, 0x1F8FF, 2 }, { 0x1F900, 0x1FBFF, 3 }, { 0x1FF80, 0x1FFFF, 0 },
+    { 0x20000, 0x3FFFD, 2 }, { 0x3FFFE, 0x3FFFF, 0 }, { 0xE0000, 0xE007F, 0 }, { 0xE0100, 0xE01EF, 0 },
+    { 0xEFF80, 0xEFFFF, 0 }, { 0xFFF80, 0xFFFFF, 2 }, { 0x10FF80, 0x10FFFF, 2 }
+};
+
+Size chart_width( UCodePoint codepoint ) noexcept
+{
+  const auto itr = std::lower_bound(
+    std::begin( code_charts ),
+    std::end( code_charts ),
+    codepoint,
+    []( const CodeChart& chart, UCodePoint value ) noexcept { return chart.end < value; } );
+  if ( itr != std::end( code_charts ) && itr->start <= codepoint )
+    return itr->width;
+  return 1;
+}
+
+Size branch_width( UCodePoint codepoint ) noexcept
+{
+    // The condition judgement here is taken directly from the standard CodeCharts file.
+
+    if ( codepoint <= 0x19 || ( codepoint >= 0x7F && codepoint <= 0xA0 ) )
+      return 0; // control characters,
+    if ( codepoint == 0xAD || ( codepoint >= 0x300 && codepoint <= 0x36F ) )
+      return 0; // combining characters
+    if ( ( codepoint >= 0x2000 && codepoint <= 0x200F ) || codepoint == 0x2011
+         || ( codepoint >= 0x2028 && codepoint <= 0x202F )
+         || ( codepoint >= 0x205F && codepoint <= 0x206F ) )
+      return 0; // General Punctuation
+    if ( codepoint >= 0xFDD0 && codepoint <= 0xFDEF )
+      return 0; // the standard said they aren't characters
+    if ( codepoint >= 0xFE00 && codepoint <= 0xFE0F )
+      return 0; // Variation Selectors
+    if ( codepoint >= 0xFE20 && codepoint <= 0xFE2F )
+      return 0; // Combining Half Marks
+    if ( codepoint == 0xFEFF )
+      return 0; // Zero width space
+    if ( ( codepoint >= 0x1FF80 && codepoint <= 0x1FFFF )
+         /*|| ( codepoint >= 0x2FF80 && codepoint <= 0x2FFFF )
+         || ( codepoint >= 0x3FF80 && codepoint <= 0x3FFFF )*/
+         || ( codepoint >= 0xEFF80 && codepoint <= 0xEFFFF ) )
+      return 0; // Unassigned
+    if ( codepoint >= 0xE0000 && codepoint <= 0xE007F )
+      return 0; // Tags
+    if ( codepoint >= 0xE0100 && codepoint <= 0xE01EF )
+      return 0; // Variation Selectors Supplement
+
+    if ( codepoint >= 0x20 && codepoint <= 0x7E )
+      return 1; // ASCII
+    if ( codepoint >= 0xA1 && codepoint <= 0x2FF && codepoint != 0xAD )
+      return 1; // Latin Extended
+    if ( ( codepoint >= 0x370 && codepoint <= 0x1FFF ) || codepoint == 0x2010
+         || ( codepoint >= 0x2012 && codepoint <= 0x2027 ) // These are General Punctuation
+         || ( codepoint >= 0x2030 && codepoint <= 0x205E )
+         || ( codepoint >= 0x2070 && codepoint <= 0x2E7F ) )
+      return 1; // other languages' characters and reserved characters
+    // I believe they are rendered to 1 character width (not pretty sure).
+    if ( codepoint >= 0xA4D0 && codepoint <= 0xA95F )
+      return 1; // Lisu, Vai, Cyrillic Extended and other characters with 1 width
+    if ( codepoint >= 0xA980 && codepoint <= 0xABFF )
+      return 1; // Javanese, not that Java run on JVM; and other characters
+    if ( ( codepoint >= 0xFB00 && codepoint <= 0xFDCF ) // Alphabetic Presentation Forms
+         || ( codepoint >= 0xFDF0 && codepoint <= 0xFDFF ) )
+      return 1; // Arabic Presentation Forms-A
+    if ( codepoint >= 0xFE70 && codepoint <= 0xFEFE )
+      return 1; // Arabic Presentation Forms-B
+    if ( ( codepoint >= 0xFF61 && codepoint <= 0xFFDF )
+         || ( codepoint >= 0xFFE7 && codepoint <= 0xFFEF ) )
+      return 1; // Halfwidth Forms
+    if ( codepoint >= 0xFFF0 && codepoint <= 0xFFFF )
+      return 1; // Specials
+
+    if ( codepoint >= 0x2E80 && codepoint <= 0xA4CF )
+      return 2; // CJK characters, phonetic scripts and reserved characters
+    // including many other symbol characters
+    if ( codepoint >= 0xA960 && codepoint <= 0xA97F )
+      return 2; // Hangul Jamo Extended
+    if ( codepoint >= 0xAC00 && codepoint <= 0xD7FF )
+      return 2; // Hangul Syllables and its extended block
+    // U+D800 to U+DFFF is Unicode Surrogate Range,
+    if ( codepoint >= 0xF900 && codepoint <= /*0xFAD9*/ 0xFAFF )
+      return 2; // CJK Compatibility Ideographs
+    if ( codepoint >= 0xFE10 && codepoint <= 0xFE1F )
+      return 2; // Vertical Forms
+    if ( codepoint >= 0xFE30 && codepoint <= 0xFE6F )
+      return 2; // CJK Compatibility Forms and Small Form Variants
+    if ( ( codepoint >= 0xFF00 && codepoint <= 0xFF60 )
+         || ( codepoint >= 0xFFE0 && codepoint <= 0xFFE6 ) )
+      return 2; // Fullwidth Forms
+    if ( codepoint >= 0x10000 && codepoint <= 0x1F8FF )
+      return 2; // Some complex characters, including emojis
+    /*if ( ( codepoint >= 0x20000 && codepoint <= 0x2A6DF )      // B
+         || ( codepoint >= 0x2A700 && codepoint <= 0x2B81D )   // C and D
+         || ( codepoint >= 0x2B820 && codepoint <= 0x2CEA1 )   // E
+         || ( codepoint >= 0x2CEB0 && codepoint <= 0x2EBE0 )   // F
+         || ( codepoint >= 0x2EBF0 && codepoint <= 0x2EE5D ) ) // I
+      return 2; // CJK Unified Ideographs Extension, B to I
+    if ( codepoint >= 0x2F800 && codepoint <= 0x2FA1D )
+      return 2; // CJK Compatibility Ideographs Supplement
+    if ( ( codepoint >= 0x30000 && codepoint <= 0x3134A )      // G
+         || ( codepoint >= 0x31350 && codepoint <= 0x323AF ) ) // H
+      return 2; // CJK Unified Ideographs Extension, G to H*/
+    if ( codepoint >= 0x20000 && codepoint <= 0x3FFFD )
+      return 2; // But EastAsianWidth said the width of this range is 'W'.
+
+    if ( ( codepoint >= 0xE000 && codepoint <= 0xF8FF )
+         || ( codepoint >= 0xFFF80 && codepoint <= 0xFFFFF )
+         || ( codepoint >= 0x10FF80 && codepoint <= 0x10FFFF ) )
+      return 2; // Private Use Area and its Supplementary
+
+    if ( codepoint >= 0x1F900 && codepoint <= 0x1FBFF )
+      return 3; // new emojis
+
+    return 1; // Default fallback
+}
+
+Size table_width( UCodePoint codepoint ) noexcept
+{
+  return pgbar::__detail::charset::U8String::char_width( codepoint );
+}
+
+template<Size ( *Width )( UCodePoint ) noexcept>
+double measure( const std::vector<UCodePoint>& codepoints )
+{
+  constexpr Size rounds = 50;
+  Size sum              = 0;
+  const auto start      = std::chrono::steady_clock::now();
+  for ( Size i = 0; i < rounds; ++i )
+    for ( const auto codepoint : codepoints )
+      sum += Width( codepoint );
+  const auto elapsed = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start );
+  // Keep the sum alive so that the loops aren't optimized away.
+  if ( sum == 0 )
+    std::fprintf( stderr, "empty input\n" );
+  return elapsed.count() / ( rounds * codepoints.size() );
+}
+
+std::vector<UCodePoint> sample( UCodePoint first, UCodePoint last, Size num )
+{
+  std::mt19937 engine { 42 };
+  std::uniform_int_distribution<UCodePoint> distribution { first, last };
+  std::vector<UCodePoint> codepoints;
+  while ( codepoints.size() < num ) {
+    const auto codepoint = distribution( engine );
+    if ( codepoint < 0xD800 || codepoint > 0xDFFF )
+      codepoints.push_back( codepoint );
+  }
+  return codepoints;
+}
+
+int main()
+{
+  constexpr Size num = 1 << 16;
+  const struct {
+    const char* name;
+    std::vector<UCodePoint> codepoints;
+  } inputs[] = {
+    { "ASCII", sample( 0x20, 0x7E, num ) },
+    { "Latin and Greek", sample( 0xA0, 0x3FF, num ) },
+    { "CJK", sample( 0x4E00, 0x9FFF, num ) },
+    { "Emoji", sample( 0x1F300, 0x1FAFF, num ) },
+    { "Whole BMP", sample( 0, 0xFFFF, num ) },
+    { "All planes", sample( 0, 0x10FFFF, num ) },
+  };
+
+  std::printf( "%-16s %16s %16s %16s\n", "input", "table (ns)", "lower_bound (ns)", "if-else (ns)" );
+  for ( const auto& input : inputs )
+    std::printf( "%-16s %16.2f %16.2f %16.2f\n",
+                 input.name,
+                 measure<table_width>( input.codepoints ),
+                 measure<chart_width>( input.codepoints ),
+                 measure<branch_width>( input.codepoints ) );
+
+  Size num_diff = 0;
+  for ( UCodePoint codepoint = 0; codepoint <= 0x10FFFF; ++codepoint )
+    num_diff += table_width( codepoint ) != chart_width( codepoint );
+  std::printf( "the former code charts disagree with the table on %zu code points\n", num_diff );
+}
@@ -0,0 +1,144 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "pgbar/pgbar.hpp"
+
+/**
+ * This file counts the heap allocations the render thread makes while a bar is running,
+ * and fails if any frame drawn after the first few allocates.
+ *
+ * Build: g++ -std=c++11 -O2 -pthread -I ../include frame-alloc-check.cpp -o frame-alloc-check
+ * The render thread is only started if the output stream is bound to a tty, so if `stdout` isn't one,
+ * e.g. in a CI job, the check runs itself again in a pseudo terminal and discards what it draws there;
+ * the bar is drawn to `stdout` while the result is printed to `stderr`. POSIX only.
+ */
+
+static std::thread::id main_thread;
+static std::atomic<bool> counting { false };
+static std::atomic<std::size_t> num_alloc { 0 };
+
+/* The replacements are kept out of line, otherwise the compiler sees `malloc` and `free` paired with
+ * `new` and `delete` in the callers and warns about mismatched allocation functions. */
+__attribute__( ( noinline ) ) static void* allocate( std::size_t size )
+{
+  if ( counting.load( std::memory_order_relaxed ) && std::this_thread::get_id() != main_thread )
+    num_alloc.fetch_add( 1, std::memory_order_relaxed );
+  if ( void* ptr = std::malloc( size == 0 ? 1 : size ) )
+    return ptr;
+  throw std::bad_alloc();
+}
+__attribute__( ( noinline ) ) static void deallocate( void* ptr ) noexcept
+{
+  std::free( ptr );
+}
+
+void* operator new( std::size_t size )
+{
+  return allocate( size );
+}
+void* operator new[]( std::size_t size )
+{
+  return allocate( size );
+}
+void operator delete( void* ptr ) noexcept
+{
+  deallocate( ptr );
+}
+void operator delete[]( void* ptr ) noexcept
+{
+  deallocate( ptr );
+}
+void operator delete( void* ptr, std::size_t ) noexcept
+{
+  deallocate( ptr );
+}
+void operator delete[]( void* ptr, std::size_t ) noexcept
+{
+  deallocate( ptr );
+}
+
+// Run the program again with `stdout` bound to a new pseudo terminal, and return its exit status.
+static int run_in_pty( char* argv[] )
+{
+  const int master = posix_openpt( O_RDWR | O_NOCTTY );
+  if ( master < 0 || grantpt( master ) != 0 || unlockpt( master ) != 0 ) {
+    std::perror( "frame-alloc-check: no pseudo terminal" );
+    return EXIT_FAILURE;
+  }
+  // Wide enough for the whole bar to fit in one line.
+  winsize size {};
+  size.ws_row = 24;
+  size.ws_col = 200;
+  ioctl( master, TIOCSWINSZ, &size );
+
+  const char* const slave_name = ptsname( master );
+  const pid_t child            = fork();
+  if ( child < 0 ) {
+    std::perror( "frame-alloc-check: fork" );
+    return EXIT_FAILURE;
+  }
+  if ( child == 0 ) {
+    const int slave = open( slave_name, O_RDWR );
+    if ( slave < 0 || dup2( slave, STDOUT_FILENO ) < 0 )
+      _exit( EXIT_FAILURE );
+    close( slave );
+    close( master );
+    execv( argv[0], argv );
+    _exit( EXIT_FAILURE );
+  }
+
+  // Keep draining the terminal, otherwise the child blocks once its buffer is full.
+  char buffer[4096];
+  int status = 0;
+  while ( waitpid( child, &status, WNOHANG ) == 0 )
+    if ( read( master, buffer, sizeof( buffer ) ) <= 0 )
+      std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+  close( master );
+  return WIFEXITED( status ) ? WEXITSTATUS( status ) : EXIT_FAILURE;
+}
+
+int main( int, char* argv[] )
+{
+  if ( !isatty( STDOUT_FILENO ) )
+    return run_in_pty( argv );
+  main_thread = std::this_thread::get_id();
+
+  constexpr std::size_t num_tasks = 1000;
+  pgbar::ProgressBar<pgbar::Threadsafe, pgbar::StreamChannel::Stdout> bar {
+    pgbar::option::Tasks( num_tasks ),
+    pgbar::option::Description( "Counting" )
+  };
+
+  // Let the buffers of the first frames grow to their final size.
+  for ( std::size_t i = 0; i < num_tasks / 10; ++i ) {
+    bar.tick();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+  }
+
+  counting.store( true );
+  const auto start = std::chrono::steady_clock::now();
+  for ( std::size_t i = num_tasks / 10; i < num_tasks - 1; ++i ) {
+    bar.tick();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+  }
+  counting.store( false );
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  bar.tick();
+
+  const auto num_frame =
+    std::chrono::duration_cast<std::chrono::milliseconds>( elapsed ) / pgbar::config::Core::refresh_interval();
+  std::fprintf( stderr,
+                "about %lld frames, %zu allocations on the render thread\n",
+                static_cast<long long>( num_frame ),
+                num_alloc.load() );
+  return num_alloc.load() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
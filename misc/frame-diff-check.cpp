@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "pgbar/pgbar.hpp"
+
+/**
+ * This file checks that the frames `FrameDiff` draws by rewriting only the changed cells
+ * leave the terminal showing exactly what the frames drawn in full show.
+ *
+ * Every kind of bar goes through a run of frames on a fake clock, and its config is changed halfway;
+ * the run is drawn both in full and through `FrameDiff`, the two outputs are fed to a small
+ * terminal emulator, and the screens are compared after every frame.
+ *
+ * Build: g++ -std=c++11 -O2 -pthread -I ../include frame-diff-check.cpp -o frame-diff-check
+ * `FrameDiff` only rewrites single cells when it knows the width of the terminal, so if `stdout`
+ * isn't a tty, the check runs itself again in a pseudo terminal; the result is printed to `stderr`.
+ * POSIX only.
+ */
+
+using namespace pgbar::__detail;
+
+static pgbar::config::Core::TimePoint fake_now { std::chrono::seconds( 1000 ) };
+static pgbar::config::Core::TimePoint fake_clock()
+{
+  return fake_now;
+}
+
+// Just enough of a terminal for the escape codes the bars write.
+class Screen {
+  struct Cell {
+    std::string glyph = " ";
+    std::string style;
+  };
+
+  std::vector<std::vector<Cell>> rows_;
+  std::size_t row_ = 0, col_ = 0;
+  std::size_t saved_row_ = 0, saved_col_ = 0;
+  std::string style_;
+
+  Cell& at( std::size_t row, std::size_t col )
+  {
+    if ( rows_.size() <= row )
+      rows_.resize( row + 1 );
+    if ( rows_[row].size() <= col )
+      rows_[row].resize( col + 1 );
+    return rows_[row][col];
+  }
+  // The style of a blank cell can't be seen.
+  static bool same( const Cell& a, const Cell& b )
+  {
+    return a.glyph == b.glyph && ( a.glyph == " " || a.style == b.style );
+  }
+
+public:
+  // Returns false if the data has an escape code the screen doesn't know.
+  bool feed( const char* data, std::size_t size )
+  {
+    for ( std::size_t i = 0; i < size; ) {
+      const auto lead = static_cast<unsigned char>( data[i] );
+      if ( lead == '\x1B' ) {
+        if ( i + 1 >= size || data[i + 1] != '[' )
+          return false;
+        auto j = i + 2;
+        while ( j < size && ( data[j] < 0x40 || data[j] > 0x7E ) )
+          ++j;
+        if ( j >= size )
+          return false;
+        const std::string param( data + i + 2, data + j );
+        const auto count = param.empty() ? 1 : std::strtoul( param.c_str(), nullptr, 10 );
+        switch ( data[j] ) {
+        case 's':
+          saved_row_ = row_;
+          saved_col_ = col_;
+          break;
+        case 'u':
+          row_ = saved_row_;
+          col_ = saved_col_;
+          break;
+        case 'X':
+          for ( std::size_t k = 0; k < count; ++k )
+            at( row_, col_ + k ) = Cell();
+          break;
+        case 'C': col_ += count; break;
+        case 'm':
+          if ( param.empty() || param == "0" )
+            style_.clear();
+          else
+            style_.append( data + i, data + j + 1 );
+          break;
+        default: return false;
+        }
+        i = j + 1;
+        continue;
+      }
+      if ( lead == '\n' ) {
+        ++row_;
+        col_ = 0;
+        ++i;
+        continue;
+      }
+
+      std::size_t len             = 1;
+      types::UCodePoint codepoint = lead;
+      if ( ( lead & 0xE0 ) == 0xC0 ) {
+        len       = 2;
+        codepoint = lead & 0x1F;
+      } else if ( ( lead & 0xF0 ) == 0xE0 ) {
+        len       = 3;
+        codepoint = lead & 0xF;
+      } else if ( ( lead & 0xF8 ) == 0xF0 ) {
+        len       = 4;
+        codepoint = lead & 0x7;
+      }
+      len = ( std::min )( len, size - i );
+      for ( std::size_t k = 1; k < len; ++k )
+        codepoint = ( codepoint << 6 ) | ( static_cast<unsigned char>( data[i + k] ) & 0x3F );
+      const auto width = charset::U8String::char_width( codepoint );
+      if ( width == 0 && col_ > 0 )
+        at( row_, col_ - 1 ).glyph.append( data + i, len );
+      else if ( width != 0 ) {
+        auto& cell = at( row_, col_ );
+        cell.glyph.assign( data + i, len );
+        cell.style = style_;
+        if ( width == 2 ) {
+          auto& rest = at( row_, col_ + 1 );
+          rest.glyph.clear();
+          rest.style = style_;
+        }
+        col_ += width;
+      }
+      i += len;
+    }
+    return true;
+  }
+
+  bool operator==( const Screen& rhs ) const
+  {
+    const Cell blank;
+    for ( std::size_t row = 0; row < ( std::max )( rows_.size(), rhs.rows_.size() ); ++row ) {
+      const auto num_col = ( std::max )( row < rows_.size() ? rows_[row].size() : 0,
+                                         row < rhs.rows_.size() ? rhs.rows_[row].size() : 0 );
+      for ( std::size_t col = 0; col < num_col; ++col ) {
+        const auto& a = row < rows_.size() && col < rows_[row].size() ? rows_[row][col] : blank;
+        const auto& b =
+          row < rhs.rows_.size() && col < rhs.rows_[row].size() ? rhs.rows_[row][col] : blank;
+        if ( !same( a, b ) )
+          return false;
+      }
+    }
+    return true;
+  }
+};
+
+class Checker {
+  Screen full_, diff_;
+  io::OStream<pgbar::StreamChannel::Stdout> stream_;
+  render::FrameDiff painter_;
+  std::size_t max_size_ = 0;
+
+  // Feed what the last frame wrote in each mode, then compare the screens.
+  void compare( const io::Stringbuf& full )
+  {
+    ++num_frame;
+    const bool known =
+      full_.feed( full.data(), full.size() ) && diff_.feed( stream_.data(), stream_.size() );
+    stream_.clear();
+    if ( !known || !( full_ == diff_ ) )
+      ++num_mismatch;
+  }
+
+public:
+  std::size_t num_frame    = 0;
+  std::size_t num_mismatch = 0;
+
+  template<typename Builder, typename Build>
+  void begin( const Builder& builder, Build&& build )
+  {
+    max_size_ = builder.full_render_size();
+    io::Stringbuf full;
+    full << "\n" << console::escape::store_cursor;
+    build( full );
+    stream_ << "\n" << console::escape::store_cursor;
+    build( painter_.canvas() );
+    painter_.draw( stream_ );
+    compare( full );
+  }
+  template<typename Builder, typename Build>
+  void frame( const Builder& builder, Build&& build )
+  {
+    max_size_ = ( std::max )( max_size_, builder.full_render_size() );
+    io::Stringbuf full;
+    full << console::escape::restore_cursor << console::escape::clear_next( max_size_ );
+    build( full );
+    build( painter_.canvas() );
+    painter_.redraw( stream_, max_size_ );
+    compare( full );
+  }
+};
+
+template<typename Config, typename Mutate>
+void run( Checker& checker, Config config, Mutate mutate )
+{
+  render::Builder<Config> builder { std::move( config ) };
+  const auto zero_point    = fake_now;
+  std::size_t num_frame    = 0;
+  std::size_t num_finished = 0;
+  auto build               = [&]( io::Stringbuf& buffer ) {
+    builder.build( buffer, num_frame, num_finished, 100, zero_point );
+  };
+  checker.begin( builder, build );
+  for ( ; num_finished <= 100; ++num_finished ) {
+    fake_now += std::chrono::milliseconds( 137 );
+    ++num_frame;
+    if ( num_finished == 40 )
+      mutate( builder );
+    checker.frame( builder, build );
+  }
+}
+template<typename Mutate>
+void run( Checker& checker, pgbar::config::BlckBar config, Mutate mutate )
+{
+  render::Builder<pgbar::config::BlckBar> builder { std::move( config ) };
+  const auto zero_point    = fake_now;
+  std::size_t num_finished = 0;
+  auto build = [&]( io::Stringbuf& buffer ) { builder.build( buffer, num_finished, 100, zero_point ); };
+  checker.begin( builder, build );
+  for ( ; num_finished <= 100; ++num_finished ) {
+    fake_now += std::chrono::milliseconds( 211 );
+    if ( num_finished == 40 )
+      mutate( builder );
+    checker.frame( builder, build );
+  }
+}
+
+// Run the program again with `stdout` bound to a new pseudo terminal, and return its exit status.
+static int run_in_pty( char* argv[] )
+{
+  const int master = posix_openpt( O_RDWR | O_NOCTTY );
+  if ( master < 0 || grantpt( master ) != 0 || unlockpt( master ) != 0 ) {
+    std::perror( "frame-diff-check: no pseudo terminal" );
+    return EXIT_FAILURE;
+  }
+  winsize size {};
+  size.ws_row = 24;
+  size.ws_col = 250;
+  ioctl( master, TIOCSWINSZ, &size );
+
+  const char* const slave_name = ptsname( master );
+  const pid_t child            = fork();
+  if ( child < 0 ) {
+    std::perror( "frame-diff-check: fork" );
+    return EXIT_FAILURE;
+  }
+  if ( child == 0 ) {
+    const int slave = open( slave_name, O_RDWR );
+    if ( slave < 0 || dup2( slave, STDOUT_FILENO ) < 0 )
+      _exit( EXIT_FAILURE );
+    close( slave );
+    close( master );
+    execv( argv[0], argv );
+    _exit( EXIT_FAILURE );
+  }
+
+  char buffer[4096];
+  int status = 0;
+  while ( waitpid( child, &status, WNOHANG ) == 0 )
+    if ( read( master, buffer, sizeof( buffer ) ) <= 0 )
+      std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+  close( master );
+  return WIFEXITED( status ) ? WEXITSTATUS( status ) : EXIT_FAILURE;
+}
+
+int main( int, char* argv[] )
+{
+  if ( !isatty( STDOUT_FILENO ) )
+    return run_in_pty( argv );
+
+  using namespace pgbar;
+  config::Core::clock( &fake_clock );
+  // The frames are built on this thread instead of the render thread.
+  render::on_render_thread() = true;
+  Checker checker;
+  run( checker, config::CharBar(), []( config::CharBar& c ) { c.description( "now longer" ); } );
+  run( checker,
+       config::CharBar( option::Description( "\xE4\xB8\x8B\xE8\xBD\xBD\xE4\xB8\xAD e\xCC\x81" ) ),
+       []( config::CharBar& c ) { c.bar_length( 20 ); } );
+  run( checker, config::CharBar( option::Style( 0xFF ), option::Colored( false ) ), []( config::CharBar& c ) {
+    c.tasks( 3 );
+  } );
+  run( checker, config::BlckBar(), []( config::BlckBar& c ) { c.colored( false ); } );
+  run( checker, config::BlckBar( option::Style( 0xFF ) ), []( config::BlckBar& c ) { c.bolded( false ); } );
+  run( checker, config::SpinBar( option::Description( "spin" ) ), []( config::SpinBar& c ) {
+    c.true_mesg( "x" );
+  } );
+  run( checker, config::ScanBar( option::Style( 0xFF ) ), []( config::ScanBar& c ) { c.bar_length( 10 ); } );
+
+  std::fprintf( stderr,
+                "%zu frames, %zu differ from the frames drawn in full\n",
+                checker.num_frame,
+                checker.num_mismatch );
+  return checker.num_mismatch == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include "pgbar/pgbar.hpp"
+
+/**
+ * This file measures the latency of the first and the last `tick()` of a progress bar,
+ * which wait for the render thread to start and to finish the bar,
+ * as well as the CPU time the ticking thread spends in them.
+ *
+ * Build: g++ -std=c++20 -O2 -pthread -I ../include handshake-bench.cpp -o handshake-bench
+ * Run it in a terminal, the render thread is only started if the output stream is bound to a tty;
+ * the bars are drawn to `stdout` while the results are printed to `stderr`.
+ */
+
+struct Sample {
+  std::chrono::nanoseconds first;
+  std::chrono::nanoseconds last;
+  std::clock_t cpu;
+};
+
+Sample measure_once()
+{
+  pgbar::ProgressBar<pgbar::Threadunsafe, pgbar::StreamChannel::Stdout> bar { pgbar::option::Tasks( 2 ) };
+
+  const auto cpu_start   = std::clock();
+  const auto first_start = std::chrono::steady_clock::now();
+  bar.tick();
+  const auto first = std::chrono::steady_clock::now() - first_start;
+
+  // Let the render thread settle in the `active` state.
+  std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+
+  const auto cpu_middle = std::clock();
+  const auto last_start = std::chrono::steady_clock::now();
+  bar.tick();
+  const auto last = std::chrono::steady_clock::now() - last_start;
+  const auto cpu  = std::clock() - cpu_middle + ( cpu_middle - cpu_start );
+
+  return { std::chrono::duration_cast<std::chrono::nanoseconds>( first ),
+           std::chrono::duration_cast<std::chrono::nanoseconds>( last ),
+           cpu };
+}
+
+double median_us( std::vector<std::chrono::nanoseconds>& samples )
+{
+  std::sort( samples.begin(), samples.end() );
+  return samples[samples.size() / 2].count() / 1000.0;
+}
+
+int main()
+{
+  constexpr std::size_t rounds = 200;
+
+  std::vector<std::chrono::nanoseconds> firsts, lasts;
+  std::clock_t cpu_total = 0;
+  const auto wall_start  = std::chrono::steady_clock::now();
+  for ( std::size_t i = 0; i < rounds; ++i ) {
+    const auto sample = measure_once();
+    firsts.push_back( sample.first );
+    lasts.push_back( sample.last );
+    cpu_total += sample.cpu;
+  }
+  const auto wall = std::chrono::duration<double>( std::chrono::steady_clock::now() - wall_start ).count();
+
+  std::fprintf( stderr,
+                "rounds: %zu\nfirst tick: %10.2f us (median)\nlast tick:  %10.2f us (median)\n",
+                rounds,
+                median_us( firsts ),
+                median_us( lasts ) );
+  std::fprintf( stderr,
+                "process cpu time: %.3f s over %.3f s of wall time\n",
+                static_cast<double>( cpu_total ) / CLOCKS_PER_SEC,
+                wall );
+}
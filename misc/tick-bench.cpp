@@ -0,0 +1,51 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "pgbar/pgbar.hpp"
+
+/**
+ * This file measures the tick throughput of a progress bar shared by 1 to N threads,
+ * comparing the lock-based `Threadsafe` mode with the `Threadsharded` and `Threadatomic` modes.
+ *
+ * Build: g++ -std=c++11 -O2 -pthread -I ../include tick-bench.cpp -o tick-bench
+ * Redirect the output to a file to keep the bar from rendering while being measured.
+ */
+
+template<typename MutexMode>
+double measure( std::size_t num_threads, std::size_t ticks_per_thread )
+{
+  pgbar::ProgressBar<MutexMode> bar { pgbar::option::Tasks( num_threads * ticks_per_thread ) };
+
+  std::vector<std::thread> workers;
+  const auto start = std::chrono::steady_clock::now();
+  for ( std::size_t i = 0; i < num_threads; ++i )
+    workers.emplace_back( [&bar, ticks_per_thread]() {
+      for ( std::size_t j = 0; j < ticks_per_thread; ++j )
+        bar.tick();
+    } );
+  for ( auto& worker : workers )
+    worker.join();
+  const auto elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+  if ( bar.is_running() )
+    std::fprintf( stderr, "error: the bar is still running after all ticks\n" );
+  return static_cast<double>( num_threads * ticks_per_thread ) / elapsed;
+}
+
+int main()
+{
+  constexpr std::size_t ticks_per_thread = 1 << 20;
+  const std::size_t max_threads = std::max<std::size_t>( std::thread::hardware_concurrency(), 1 );
+
+  std::printf( "%8s %24s %24s %24s\n", "threads", "Threadsafe (tick/s)", "Threadsharded (tick/s)",
+               "Threadatomic (tick/s)" );
+  for ( std::size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2 ) {
+    const auto locked  = measure<pgbar::Threadsafe>( num_threads, ticks_per_thread );
+    const auto sharded = measure<pgbar::Threadsharded>( num_threads, ticks_per_thread );
+    const auto atomic  = measure<pgbar::Threadatomic>( num_threads, ticks_per_thread );
+    std::printf( "%8zu %24.0f %24.0f %24.0f\n", num_threads, locked, sharded, atomic );
+  }
+}
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+This file generates the two-level width table `pgbar::__detail::charset::WidthTable`
+from the Unicode Character Database bundled with the running Python interpreter.
+
+Usage: python3 unicode-width.py > table.txt
+Then replace the members of `WidthTable` in include/pgbar/pgbar.hpp, from the line
+"Generated by" to the end of the class, with the output.
+
+The rules follow the usual terminal conventions:
+- control characters, combining marks, format characters and the conjoining Hangul vowels
+  and trailing consonants take no column;
+- the East Asian Wide and Fullwidth characters, which include every character with the
+  Emoji_Presentation property since Unicode 9.0, take two columns;
+- everything else takes one column.
+"""
+
+import unicodedata
+
+PAGE_BITS = 7
+PAGE_SIZE = 1 << PAGE_BITS
+TABLE_END = 0x40000  # Planes 4 and above are handled without the table.
+MEMBER, ELEMENT = " " * 8, " " * 10
+
+# The ranges whose unassigned code points default to Wide in EastAsianWidth.txt.
+WIDE_DEFAULTS = ((0x3400, 0x4DBF), (0x4E00, 0x9FFF), (0xF900, 0xFAFF), (0x1F000, 0x1FAFF),
+                 (0x1FC00, 0x1FFFD), (0x20000, 0x2FFFD), (0x30000, 0x3FFFD))
+# The unassigned code points with the Default_Ignorable_Code_Point property.
+IGNORABLE = ((0x2065, 0x2065), (0xFFF0, 0xFFF8), (0xE0000, 0xE0FFF))
+
+
+def within(codepoint, ranges):
+    return any(start <= codepoint <= end for start, end in ranges)
+
+
+def width(codepoint):
+    char = chr(codepoint)
+    category = unicodedata.category(char)
+    if category in ("Cc", "Mn", "Me", "Cf", "Zl", "Zp"):
+        return 0
+    if 0x1160 <= codepoint <= 0x11FF or 0xD7B0 <= codepoint <= 0xD7FF:
+        return 0
+    if category == "Cn":
+        if within(codepoint, IGNORABLE):
+            return 0
+        return 2 if within(codepoint, WIDE_DEFAULTS) else 1
+    return 2 if unicodedata.east_asian_width(char) in ("W", "F") else 1
+
+
+def main():
+    widths = [width(codepoint) for codepoint in range(TABLE_END)]
+
+    # The code points above the table must match the rule used by `char_width`.
+    for codepoint in range(TABLE_END, 0x110000):
+        assert width(codepoint) == (0 if codepoint >> 12 == 0xE0 else 1)
+
+    pages, index = [], {}
+    for start in range(0, TABLE_END, PAGE_SIZE):
+        page = tuple(widths[start:start + PAGE_SIZE])
+        pages.append(index.setdefault(page, len(index)))
+    assert len(index) <= 256
+
+    words = []
+    for page in sorted(index, key=index.get):
+        for start in range(0, PAGE_SIZE, 32):
+            word = 0
+            for offset, value in enumerate(page[start:start + 32]):
+                word |= value << (offset * 2)
+            words.append(word)
+
+    print(f"{MEMBER}// Generated by misc/unicode-width.py from the Unicode Character Database "
+          f"{unicodedata.unidata_version}.")
+    print(f"{MEMBER}static constexpr types::Size page_bits = {PAGE_BITS};")
+    print(f"{MEMBER}// The distinct page index of each {PAGE_SIZE} code points below U+{TABLE_END:X}.")
+    print(f"{MEMBER}static constexpr std::uint8_t pages[{len(pages)}] = {{")
+    for row in range(0, len(pages), 16):
+        print(ELEMENT + ", ".join(str(value) for value in pages[row:row + 16]) + ",")
+    print(MEMBER + "};")
+    print(MEMBER + "// The widths of each distinct page, 2 bits per code point and 32 code points per word.")
+    print(f"{MEMBER}static constexpr std::uint64_t widths[{len(words)}] = {{")
+    per_page = PAGE_SIZE // 32
+    for row in range(0, len(words), per_page):
+        print(ELEMENT + ", ".join(f"0x{value:016X}" for value in words[row:row + per_page]) + ",")
+    print(MEMBER + "};")
+
+
+if __name__ == "__main__":
+    main()